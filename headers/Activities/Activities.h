@@ -12,6 +12,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <map>
+#include <cstdint>
 
 using namespace std;
 using namespace filesystem;
@@ -20,6 +21,8 @@ namespace GraphModule
 {
     class UndirectedGraph;
     class DirectedGraph;
+    class AbstractGraph;
+    enum class DistanceType : uint32_t;
 }
 
 namespace GraphActivity
@@ -43,6 +46,24 @@ namespace GraphActivity
 
             static void buildGraphFromInputFile(GraphModule::DirectedGraph* graph, string inputFilePath);
 
+            static void buildGraphFromGraphFile(GraphModule::AbstractGraph* graph, const string& inputFilePath);
+
+            static void writeGraphFile(const string& graphFilePath);
+
+            static string contractionHierarchyPath(const string& graphFilePath);
+
+            static void writeContractionHierarchy(const string& graphFilePath);
+
+            static string landmarksPath(const string& graphFilePath);
+
+            static void writeLandmarks(const string& graphFilePath, int numberOfLandmarks);
+
+            static string distanceMatrixPath(const string& graphFilePath);
+
+            static void writeDistanceMatrix(const string& graphFilePath, GraphModule::DistanceType type);
+
+            static string graphKindFromInputFile(const string& graphFilePath);
+
             static void checkGraphKindFromInputFile(const string& graphFilePath, const string& expectedKind);
 
             template <typename Graph>
@@ -0,0 +1,80 @@
+#ifndef PajekLoader_h
+#define PajekLoader_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/ArcAttributes.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class UndirectedGraph;
+    class DirectedGraph;
+    class AbstractGraph;
+    class MappedFile;
+}
+
+namespace GraphActivity
+{
+    // Reads a Pajek file (*vertices, *edges and *arcs sections) through a memory map. Numbers are parsed in place with
+    // from_chars and connections are collected in flat arrays, so the graph is built in one pass once the file is read.
+    // Large *edges and *arcs sections are split at line boundaries and parsed by one thread per core.
+    class PajekLoader
+    {
+        public:
+            explicit PajekLoader(const string& inputFilePath);
+
+            void build(GraphModule::UndirectedGraph* graph);
+
+            void build(GraphModule::DirectedGraph* graph);
+
+            static string detectKind(const string& inputFilePath);
+
+            ~PajekLoader();
+
+        private:
+            enum Section { NONE, VERTICES, EDGES, ARCS };
+
+            static constexpr size_t MINIMUM_CHUNK_SIZE = 1 << 18; // Bytes of connection lines per parsing thread
+
+            struct ConnectionBuffer
+            {
+                vector<int> sources; // Vertex numbers as written in the file
+                vector<int> targets;
+                vector<float> weights;
+                vector<GraphModule::ArcAttributes::Tail> tails; // Attributes after the weight, empty ranges when there are none
+                bool hasTails = false;
+            };
+
+            static const char* findNextHeader(const char* begin, const char* end);
+
+            static Section parseSectionHeader(const char* begin, const char* end);
+
+            void parseVertex(const char* begin, const char* end);
+
+            void parseConnections(const char* begin, const char* end, bool bothWays);
+
+            void parseConnection(const char* begin, const char* end, ConnectionBuffer& buffer) const;
+
+            void addNodes(GraphModule::AbstractGraph* graph, uint32_t numberOfConnections);
+
+            uint32_t nodeIndex(int number);
+
+            shared_ptr<GraphModule::MappedFile> file; // Shared with the ArcAttributes of the graphs built from it
+            vector<int> numbers;
+            vector<string> names;
+            vector<float> coordinates; // Pajek layout, the two numbers after the label of each vertex
+            bool everyVertexHasCoordinates;
+            ConnectionBuffer connections;
+            vector<bool> bothWays; // Lines of an *edges section
+            uint32_t numberOfEdgeLines;
+            uint32_t numberOfDeclaredVertices; // Count of the *vertices header, stands in for missing vertex lines
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef QueryServer_h
+#define QueryServer_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class AbstractGraph;
+    class UndirectedGraph;
+    class DirectedGraph;
+    class MultiSourceBFS;
+    class ContractionHierarchy;
+}
+
+namespace GraphActivity
+{
+    // Long running mode that builds one graph and answers line-delimited queries against it, read from stdin or from the
+    // clients of a Unix socket. Vertices are numbered from 1 as in the input files. Every answer is one JSON object on
+    // one line that carries the query, its status and the time spent answering it.
+    //
+    //   info                       vertices, arcs and direction of the graph
+    //   degree <v>                 degree of v
+    //   bfs <s>                    hop distances from s, the number of levels and of bottom-up steps
+    //   eccentricity [<s> ...]     eccentricity, vertices reached and closeness of every s, of all vertices when none
+    //                              is given, by BFS from 256 vertices at a time
+    //   dijkstra <s> [<t>]         distances from s, or the distance and path to t
+    //   radix-dijkstra <s> [<t>]   the same over a radix heap, for non-negative integer weights
+    //   delta-stepping <s> [<t>]   the same by parallel delta-stepping, for non-negative weights
+    //   trees <s> [<s> ...]        distances from every s, one row per s, by dijkstra spread over the cores
+    //   benchmark <s> [<runs>]     mean time of dijkstra from s with each queue, the speedups over the indexed heap, and
+    //                              whether they agree and their parents give real shortest paths
+    //   path <s> <t>               distance and path from s to t by bidirectional Dijkstra, with the vertices it settled
+    //   astar <s> <t>              the same by A* over the vertex coordinates
+    //   alt <s> <t>                the same by A* over landmarks, read from <GraphFile>.alt when present
+    //   ch <s> <t>                 the same over the contraction hierarchy, read from <GraphFile>.ch when present (directed)
+    //   scc                        number of strongly connected components, the size of the largest and the arcs of the
+    //                              condensation (directed)
+    //   maxflow <s> <t>            Edmonds-Karp maximum flow (directed)
+    //   quit                       ends the session
+    class QueryServer
+    {
+        public:
+            explicit QueryServer(const string& graphFilePath);
+
+            void serve(istream& input, ostream& output);
+
+            void serveSocket(const string& socketPath);
+
+            string answer(const string& request, bool& quit);
+
+            ~QueryServer();
+
+        private:
+            string run(const string& query, const vector<int>& arguments);
+
+            int vertexIndex(int number);
+
+            string graphFilePath;
+            unique_ptr<GraphModule::UndirectedGraph> undirectedGraph; // Only one of the two is built, after the kind of the input
+            unique_ptr<GraphModule::DirectedGraph> directedGraph;
+            GraphModule::AbstractGraph* graph;
+            unique_ptr<GraphModule::MultiSourceBFS> multiSourceBFS; // Built on its first query, the graph keeps the point-to-point engines
+            bool landmarksReady; // The landmark file was looked for, the graph keeps the landmarks itself
+            bool contractionHierarchyReady; // The hierarchy file was looked for, the directed graph keeps the hierarchy itself
+            double loadMilliseconds;
+            uint64_t numberOfQueries;
+    };
+}
+
+#endif
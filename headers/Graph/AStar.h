@@ -0,0 +1,62 @@
+#ifndef AStar_h
+#define AStar_h
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/IndexedHeap.h"
+#include "Graph/ArrayView.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+    class Landmarks;
+
+    // Point-to-point A* guided by the vertex coordinates. Coordinates are read as longitude and latitude in degrees
+    // when they all fit, and then the bound is the great-circle distance, otherwise it is the plain Euclidean one.
+    // The bound is scaled by the smallest weight per unit of distance over all arcs, the fastest speed of the graph,
+    // which keeps the heuristic consistent for whatever the weights measure. Weights are truncated to int as in dijkstra.
+    // Built from Landmarks instead, it runs ALT: the bound is the landmark triangle inequality and no coordinates are needed.
+    class AStar
+    {
+        public:
+            AStar(shared_ptr<const CSRGraph> snapshot, ArrayView<float> coordinates);
+
+            explicit AStar(shared_ptr<const Landmarks> landmarks);
+
+            tuple<int, vector<int>> shortestPath(int startNodeIndex, int endNodeIndex);
+
+            int getNumberOfSettledVertices() const;
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~AStar();
+
+        private:
+            double distanceBetween(int u, int v) const;
+
+            double lowerBound(int vertex, int target) const;
+
+            void prepareQueries();
+
+            shared_ptr<const CSRGraph> snapshot;
+            vector<float> coordinates; // x and y of vertex i at [2 * i, 2 * i + 1]
+            bool geographic;
+            double weightPerDistance; // Lower bound of weight / distance over all arcs, 0 turns the search into Dijkstra
+            shared_ptr<const Landmarks> landmarks; // Replaces the coordinates when set
+            IndexedHeap<double> heap;
+            vector<int> distances;
+            vector<int> parents;
+            vector<uint32_t> reachedStamps;
+            vector<uint32_t> settledStamps;
+            uint32_t query;
+            int numberOfSettledVertices;
+    };
+}
+
+#endif
@@ -5,6 +5,10 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <tuple>
+#include <cstdint>
+
+#include "Graph/ShortestPathTrees.h"
 
 using namespace std;
 
@@ -12,6 +16,19 @@ namespace GraphModule
 {
     class Node;
     class Connection;
+    class CSRGraph;
+    class GraphStorage;
+    class BidirectionalDijkstra;
+    class BatchedDijkstra;
+    class AStar;
+    class Landmarks;
+    class GraphFile;
+    class BreadthFirstSearch;
+
+    // Priority queue behind dijkstra. The radix heap only takes non-negative integer weights, which every
+    // weight is truncated to anyway, and skips comparisons entirely. Delta-stepping replaces the queue by distance
+    // buckets relaxed on every core, with delta tuned from the weights.
+    enum class DijkstraQueue { INDEXED_HEAP, RADIX_HEAP, DELTA_STEPPING };
 
     class AbstractGraph
     {
@@ -22,19 +39,75 @@ namespace GraphModule
 
             vector<int> getNodeKeys();
 
-            vector<shared_ptr<Node>> getNodes();
+            const vector<shared_ptr<Node>>& getNodes();
 
             virtual int getDegreeOfNode(int nodeKey) = 0;
 
+            virtual vector<int> degreeSequence() = 0;
+
+            virtual bool isDirected() = 0;
+
             void addNode(const shared_ptr<Node>& node);
 
+            void reserve(int numberOfVertices, int numberOfConnections);
+
+            // Takes the graph of a file into this empty graph. It keeps reading from the mapping, see GraphStorage.
+            void load(shared_ptr<const GraphFile> file);
+
             void showNodes();
 
+            shared_ptr<const CSRGraph> getSnapshot();
+
+            GraphStorage& getStorage();
+
+            // The BFS itself, with its levels as lists of vertices, over the arcs in their direction on directed graphs.
+            // Large steps run on every core.
+            BreadthFirstSearch breadthFirstLevels(int startNodeIndex);
+
+            tuple<vector<int>, vector<int>> dijkstra(int startNodeIndex, DijkstraQueue queue = DijkstraQueue::INDEXED_HEAP);
+
+            // Parallel dijkstra over buckets of width delta, the mean weight when delta is 0. D is the same as dijkstra's and
+            // A is a shortest path tree, which may pick another parent than dijkstra where two paths tie.
+            tuple<vector<int>, vector<int>> deltaStepping(int startNodeIndex, int delta = 0);
+
+            // Distance and path from start to end by bidirectional Dijkstra. Like aStar, landmarkAStar and the contraction
+            // hierarchy, it returns the full distance however long, and 1000000 with an empty path when end is unreachable.
+            tuple<int, vector<int>> shortestPath(int startNodeIndex, int endNodeIndex);
+
+            // One dijkstra from every start vertex, spread over the cores, in one row per start vertex.
+            ShortestPathTrees shortestPathTrees(const vector<int>& startNodeIndexes);
+
+            tuple<int, vector<int>> aStar(int startNodeIndex, int endNodeIndex);
+
+            // Chooses landmarks for the current snapshot the first time, and again after the graph changes.
+            const shared_ptr<Landmarks>& getLandmarks();
+
+            // Uses landmarks loaded from disk, which must belong to the current snapshot.
+            void setLandmarks(shared_ptr<Landmarks> landmarks);
+
+            tuple<int, vector<int>> landmarkAStar(int startNodeIndex, int endNodeIndex);
+
+            // Vertices the last shortestPath, aStar or landmarkAStar settled.
+            int getNumberOfSettledVertices();
+
             virtual ~AbstractGraph();
 
         protected:
+            BatchedDijkstra& getBatchedDijkstra();
+
+            tuple<vector<int>, vector<int>> radixHeapDijkstra(int startNodeIndex);
+
+            // Counts the connections of a file just loaded and takes whatever else the file keeps for the graph kind.
+            virtual void loadConnections(const GraphFile& file) = 0;
+
             int numberOfVertices;
-            vector<shared_ptr<Node>> nodes;
+            shared_ptr<GraphStorage> storage; // Owns the nodes, the connections and the snapshot built from them, shared with Connection handles
+            shared_ptr<BidirectionalDijkstra> pointToPoint; // Kept between queries while the snapshot stays the same
+            shared_ptr<BatchedDijkstra> manySources; // Keeps its workspaces between queries while the snapshot stays the same
+            shared_ptr<AStar> goalDirected;
+            shared_ptr<Landmarks> landmarks;
+            shared_ptr<AStar> landmarkDirected; // A* over the landmarks above
+            int numberOfSettledVertices;
     };
 }
 
@@ -0,0 +1,74 @@
+#ifndef ArcAttributes_h
+#define ArcAttributes_h
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class MappedFile;
+
+    // Attributes written after the weight of each connection line, as the "highway primary lanes 2 oneway yes" tails of
+    // the OSM extracts. Only the position of every tail in the mapped input is kept while loading. A column is parsed
+    // the first time it is asked for and then kept as one byte per connection, indexed by the connection id of the storage.
+    // Connections without the attribute, or added after the load, read as UNKNOWN.
+    class ArcAttributes
+    {
+        public:
+            static constexpr uint8_t UNKNOWN = 0;
+
+            enum Oneway : uint8_t { ONEWAY_UNKNOWN = 0, ONEWAY_YES, ONEWAY_NO, ONEWAY_REVERSE };
+
+            struct Tail
+            {
+                uint64_t position; // Byte position of the tail in the source file
+                uint32_t length;
+            };
+
+            ArcAttributes(shared_ptr<const MappedFile> source, vector<Tail> tails);
+
+            uint32_t getNumberOfConnections() const;
+
+            string getAttribute(uint32_t connection, const string& key) const;
+
+            const vector<uint8_t>& getHighways();
+
+            uint8_t getHighway(uint32_t connection);
+
+            const string& getHighwayName(uint8_t highway) const;
+
+            uint8_t findHighway(const string& highwayName) const;
+
+            const vector<uint8_t>& getLanes();
+
+            const vector<uint8_t>& getMaxSpeeds();
+
+            const vector<uint8_t>& getOneways();
+
+            ~ArcAttributes();
+
+        private:
+            string_view getTail(uint32_t connection) const;
+
+            static string_view findValue(string_view tail, string_view key);
+
+            template <typename ParseValue>
+            vector<uint8_t> parseColumn(string_view key, ParseValue parseValue) const;
+
+            shared_ptr<const MappedFile> source; // Keeps the input mapped until every column has been parsed
+            vector<Tail> tails;
+            vector<uint8_t> highways; // Each column stays empty until it is requested
+            vector<string> highwayNames; // Interned highway classes, highwayNames[0] is the unknown class
+            vector<uint8_t> lanes;
+            vector<uint8_t> maxSpeeds; // km/h, clamped to 255
+            vector<uint8_t> oneways;
+    };
+}
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef ArrayView_h
+#define ArrayView_h
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Read-only view over a contiguous array, either a vector or a section of a memory map. It owns nothing, whoever
+    // hands it out keeps the array alive.
+    template <typename T>
+    class ArrayView
+    {
+        public:
+            ArrayView();
+
+            ArrayView(const T* values, size_t count);
+
+            ArrayView(const vector<T>& values);
+
+            const T& operator[](size_t i) const;
+
+            const T* data() const;
+
+            size_t size() const;
+
+            bool empty() const;
+
+            const T* begin() const;
+
+            const T* end() const;
+
+        private:
+            const T* values;
+            size_t count;
+    };
+}
+
+// Inline in header because of templates.
+template <typename T>
+GraphModule::ArrayView<T>::ArrayView()
+    : values(nullptr), count(0)
+{
+}
+
+template <typename T>
+GraphModule::ArrayView<T>::ArrayView(const T* values, size_t count)
+    : values(values), count(count)
+{
+}
+
+template <typename T>
+GraphModule::ArrayView<T>::ArrayView(const vector<T>& values)
+    : values(values.data()), count(values.size())
+{
+}
+
+template <typename T>
+const T& GraphModule::ArrayView<T>::operator[](size_t i) const
+{
+    return this->values[i];
+}
+
+template <typename T>
+const T* GraphModule::ArrayView<T>::data() const
+{
+    return this->values;
+}
+
+template <typename T>
+size_t GraphModule::ArrayView<T>::size() const
+{
+    return this->count;
+}
+
+template <typename T>
+bool GraphModule::ArrayView<T>::empty() const
+{
+    return this->count == 0;
+}
+
+template <typename T>
+const T* GraphModule::ArrayView<T>::begin() const
+{
+    return this->values;
+}
+
+template <typename T>
+const T* GraphModule::ArrayView<T>::end() const
+{
+    return this->values + this->count;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef BatchedDijkstra_h
+#define BatchedDijkstra_h
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+
+#include "Graph/DijkstraWorkspace.h"
+#include "Graph/ShortestPathTrees.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // Runs dijkstra from many sources over one snapshot. Every core gets a workspace of its own, kept from batch to
+    // batch, and takes the next source of the batch as soon as it is done with one, so a few large trees do not hold
+    // the others back. Every tree goes straight to its row of the result.
+    class BatchedDijkstra
+    {
+        public:
+            explicit BatchedDijkstra(shared_ptr<const CSRGraph> snapshot);
+
+            ShortestPathTrees run(const vector<int>& sources);
+
+            // The D and A of a single source, computed on the calling thread.
+            tuple<vector<int>, vector<int>> run(int source);
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~BatchedDijkstra();
+
+        private:
+            DijkstraWorkspace& getWorkspace(int index);
+
+            shared_ptr<const CSRGraph> snapshot;
+            vector<unique_ptr<DijkstraWorkspace>> workspaces; // One per thread, made the first time a batch needs it
+    };
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef BidirectionalDijkstra_h
+#define BidirectionalDijkstra_h
+
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/IndexedHeap.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // Point-to-point Dijkstra that grows one ball from the start over the arcs and one from the end over the reverse
+    // arcs, always advancing the side with the smaller frontier distance. It stops once the two frontier distances add
+    // up to at least the best path seen, which is then the shortest. Weights are truncated to int as in dijkstra.
+    // Per-vertex arrays are allocated once and stamped per query, so a query only touches the vertices of the two balls.
+    class BidirectionalDijkstra
+    {
+        public:
+            explicit BidirectionalDijkstra(shared_ptr<const CSRGraph> snapshot);
+
+            tuple<int, vector<int>> shortestPath(int startNodeIndex, int endNodeIndex);
+
+            int getNumberOfSettledVertices() const;
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~BidirectionalDijkstra();
+
+        private:
+            static constexpr int FORWARD = 0;
+            static constexpr int BACKWARD = 1;
+
+            void reach(int side, int vertex, int distance, int parent);
+
+            bool isReached(int side, int vertex) const;
+
+            shared_ptr<const CSRGraph> snapshot;
+            IndexedHeap<int> heaps[2];
+            vector<int> distances[2];
+            vector<int> parents[2];
+            vector<uint32_t> reachedStamps[2]; // A vertex is reached on a side when its stamp is the current query
+            vector<uint32_t> settledStamps[2];
+            uint32_t query;
+            int numberOfSettledVertices;
+    };
+}
+
+#endif
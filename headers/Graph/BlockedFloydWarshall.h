@@ -0,0 +1,254 @@
+#ifndef BlockedFloydWarshall_h
+#define BlockedFloydWarshall_h
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+
+#include "Graph/DistanceMatrix.h"
+
+using namespace std;
+
+// The min-plus kernel is built twice on x86-64, plain and for AVX2, and the loader picks the one the processor runs.
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define BLOCKED_FLOYD_WARSHALL_CLONES __attribute__((target_clones("avx2", "default")))
+#endif
+#endif
+#ifndef BLOCKED_FLOYD_WARSHALL_CLONES
+#define BLOCKED_FLOYD_WARSHALL_CLONES
+#endif
+
+namespace GraphModule
+{
+    // Floyd-Warshall over a flat row-major matrix split in TILE x TILE tiles, so the three tiles a step reads stay in cache.
+    // For every diagonal tile kb, the tile itself is closed first, then the tiles of row and column kb, which only depend
+    // on it, and last every other tile, which only depends on the row and column. Each group is spread over the cores.
+    // The stride must be a multiple of TILE and the matrix is best aligned to 64 bytes. Padding cells hold infinity.
+    // Sums go through DistanceTraits, which saturates the 16-bit distances at their infinity. With a next-hop matrix,
+    // every improvement of (i, j) through k also copies the hop of (i, k), in the same branchless pass.
+    template <typename Distance>
+    class BlockedFloydWarshall
+    {
+        public:
+            static constexpr int TILE = 64;
+
+            static void run(Distance* matrix, int stride);
+
+            template <typename Hop>
+            static void run(Distance* matrix, Hop* nextHops, int stride);
+
+            static int paddedSize(int size);
+
+        private:
+            struct NoHop
+            {
+            };
+
+            template <typename Hop>
+            static void closeTile(Distance* target, Hop* targetHops, const Distance* left, const Hop* leftHops, const Distance* top, int stride);
+
+            template <typename Hop>
+            static void relaxTile(Distance* __restrict target, Hop* __restrict targetHops, const Distance* __restrict left,
+                                  const Hop* __restrict leftHops, const Distance* __restrict top, int stride);
+
+            template <typename Work>
+            static void forEachTile(int count, const Work& work);
+    };
+}
+
+// Inline in header because of templates.
+template <typename Distance>
+int GraphModule::BlockedFloydWarshall<Distance>::paddedSize(int size)
+{
+    return (size + TILE - 1) / TILE * TILE;
+}
+
+template <typename Distance>
+void GraphModule::BlockedFloydWarshall<Distance>::run(Distance* matrix, int stride)
+{
+    run(matrix, static_cast<NoHop*>(nullptr), stride);
+}
+
+template <typename Distance>
+template <typename Hop>
+void GraphModule::BlockedFloydWarshall<Distance>::run(Distance* matrix, Hop* nextHops, int stride)
+{
+    int tiles = stride / TILE;
+    auto offset = [stride](int row, int column)
+    {
+        return static_cast<size_t>(row) * TILE * stride + static_cast<size_t>(column) * TILE;
+    };
+    auto hops = [nextHops, &offset](int row, int column)
+    {
+        return nextHops == nullptr ? nullptr : nextHops + offset(row, column);
+    };
+
+    for (int kb = 0; kb < tiles; kb++)
+    {
+        Distance* diagonal = matrix + offset(kb, kb);
+        closeTile(diagonal, hops(kb, kb), diagonal, hops(kb, kb), diagonal, stride);
+
+        // Tiles 0..tiles - 2 of row kb and then of column kb, skipping the diagonal one
+        forEachTile(2 * (tiles - 1), [&](int index)
+        {
+            int other = index % (tiles - 1);
+            other += other >= kb ? 1 : 0;
+            if (index < tiles - 1)
+            {
+                Distance* target = matrix + offset(kb, other);
+                closeTile(target, hops(kb, other), diagonal, hops(kb, kb), target, stride);
+            }
+            else
+            {
+                Distance* target = matrix + offset(other, kb);
+                closeTile(target, hops(other, kb), target, hops(other, kb), diagonal, stride);
+            }
+        });
+
+        forEachTile((tiles - 1) * (tiles - 1), [&](int index)
+        {
+            int row = index / (tiles - 1);
+            int column = index % (tiles - 1);
+            row += row >= kb ? 1 : 0;
+            column += column >= kb ? 1 : 0;
+            relaxTile(matrix + offset(row, column), hops(row, column), matrix + offset(row, kb), hops(row, kb), matrix + offset(kb, column), stride);
+        });
+    }
+}
+
+template <typename Distance>
+template <typename Hop>
+void GraphModule::BlockedFloydWarshall<Distance>::closeTile(Distance* target, Hop* targetHops, const Distance* left, const Hop* leftHops,
+                                                            const Distance* top, int stride)
+{
+    // The target may be the left or the top tile, so k has to be the outer loop as in the plain algorithm.
+    for (int k = 0; k < TILE; k++)
+    {
+        const Distance* topRow = top + static_cast<size_t>(k) * stride;
+        for (int i = 0; i < TILE; i++)
+        {
+            Distance* targetRow = target + static_cast<size_t>(i) * stride;
+            Distance through = left[static_cast<size_t>(i) * stride + k];
+            if constexpr (is_same<Hop, NoHop>::value)
+            {
+                for (int j = 0; j < TILE; j++)
+                {
+                    Distance candidate = DistanceTraits<Distance>::add(through, topRow[j]);
+                    targetRow[j] = candidate < targetRow[j] ? candidate : targetRow[j];
+                }
+            }
+            else
+            {
+                Hop* hopRow = targetHops + static_cast<size_t>(i) * stride;
+                Hop hop = leftHops[static_cast<size_t>(i) * stride + k];
+                for (int j = 0; j < TILE; j++)
+                {
+                    Distance candidate = DistanceTraits<Distance>::add(through, topRow[j]);
+                    Distance shortest = candidate < targetRow[j] ? candidate : targetRow[j];
+                    hopRow[j] = shortest != targetRow[j] ? hop : hopRow[j];
+                    targetRow[j] = shortest;
+                }
+            }
+        }
+    }
+}
+
+template <typename Distance>
+template <typename Hop>
+BLOCKED_FLOYD_WARSHALL_CLONES
+void GraphModule::BlockedFloydWarshall<Distance>::relaxTile(Distance* __restrict target, Hop* __restrict targetHops, const Distance* __restrict left,
+                                                            const Hop* __restrict leftHops, const Distance* __restrict top, int stride)
+{
+    // Min-plus product into a tile that neither input overlaps. The target row is kept in a local copy and the inner
+    // loop has no branch and no aliasing, so it compiles to vector adds and mins over the whole row.
+    for (int i = 0; i < TILE; i++)
+    {
+        Distance* targetRow = target + static_cast<size_t>(i) * stride;
+        Distance row[TILE];
+        for (int j = 0; j < TILE; j++)
+        {
+            row[j] = targetRow[j];
+        }
+        if constexpr (is_same<Hop, NoHop>::value)
+        {
+            for (int k = 0; k < TILE; k++)
+            {
+                const Distance* topRow = top + static_cast<size_t>(k) * stride;
+                Distance through = left[static_cast<size_t>(i) * stride + k];
+                for (int j = 0; j < TILE; j++)
+                {
+                    Distance candidate = DistanceTraits<Distance>::add(through, topRow[j]);
+                    row[j] = candidate < row[j] ? candidate : row[j];
+                }
+            }
+        }
+        else
+        {
+            Hop* hopRow = targetHops + static_cast<size_t>(i) * stride;
+            Hop rowHops[TILE];
+            for (int j = 0; j < TILE; j++)
+            {
+                rowHops[j] = hopRow[j];
+            }
+            for (int k = 0; k < TILE; k++)
+            {
+                const Distance* topRow = top + static_cast<size_t>(k) * stride;
+                Distance through = left[static_cast<size_t>(i) * stride + k];
+                Hop hop = leftHops[static_cast<size_t>(i) * stride + k];
+                for (int j = 0; j < TILE; j++)
+                {
+                    // Comparing the new minimum with the old one, rather than keeping the comparison, keeps both
+                    // updates as vector blends when the two types differ in width.
+                    Distance candidate = DistanceTraits<Distance>::add(through, topRow[j]);
+                    Distance shortest = candidate < row[j] ? candidate : row[j];
+                    rowHops[j] = shortest != row[j] ? hop : rowHops[j];
+                    row[j] = shortest;
+                }
+            }
+            for (int j = 0; j < TILE; j++)
+            {
+                hopRow[j] = rowHops[j];
+            }
+        }
+        for (int j = 0; j < TILE; j++)
+        {
+            targetRow[j] = row[j];
+        }
+    }
+}
+
+template <typename Distance>
+template <typename Work>
+void GraphModule::BlockedFloydWarshall<Distance>::forEachTile(int count, const Work& work)
+{
+    int numberOfThreads = min(count, static_cast<int>(max(1u, thread::hardware_concurrency())));
+    if (numberOfThreads <= 1)
+    {
+        for (int index = 0; index < count; index++)
+        {
+            work(index);
+        }
+        return;
+    }
+
+    vector<thread> threads;
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        threads.emplace_back([&work, t, count, numberOfThreads]()
+        {
+            for (int index = t; index < count; index += numberOfThreads)
+            {
+                work(index);
+            }
+        });
+    }
+    for (thread& worker : threads)
+    {
+        worker.join();
+    }
+}
+
+#endif
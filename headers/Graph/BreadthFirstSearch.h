@@ -0,0 +1,99 @@
+#ifndef BreadthFirstSearch_h
+#define BreadthFirstSearch_h
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // Level-synchronous BFS that picks the direction of every step (Beamer). Top-down steps go over the arcs of the
+    // frontier and claim unvisited vertices in a bitmap. Bottom-up steps go over the unvisited vertices, each stopping
+    // at its first in-neighbour in the bitmap of the frontier, which is far less work once the frontier holds a large
+    // part of the graph. Steps with enough work are split over the cores.
+    // Levels are kept as they are found, in one flat array cut by offsets, each in ascending vertex order. Distances are
+    // the ones of BFS, 1000000 when unreachable. Parents form a BFS tree, in which a vertex may hang from another
+    // neighbour one level up than the one the queue based search picks.
+    class BreadthFirstSearch
+    {
+        public:
+            BreadthFirstSearch(shared_ptr<const CSRGraph> snapshot, int startNodeIndex);
+
+            int getStartNodeIndex() const;
+
+            const vector<int>& getDistances() const;
+
+            const vector<int>& getParents() const;
+
+            int getNumberOfLevels() const;
+
+            // Level k is levelVertices[levelOffsets[k], levelOffsets[k + 1]).
+            const vector<int>& getLevelOffsets() const;
+
+            const vector<int>& getLevelVertices() const;
+
+            int getNumberOfBottomUpSteps() const;
+
+            ~BreadthFirstSearch();
+
+        private:
+            static constexpr int INFINITE_DISTANCE = 1000000; // Same infinity as BFS
+            static constexpr int ALPHA = 14; // Bottom-up once the frontier has more than 1 / ALPHA of the unexplored arcs
+            static constexpr int BETA = 24; // Top-down again once a shrinking frontier has under 1 / BETA of the vertices
+            static constexpr int PARALLEL_GRAIN = 16384; // Steps over fewer arcs or vertices run on the calling thread
+
+            int topDownStep(int level, int numberOfThreads);
+
+            int bottomUpStep(int level, int numberOfThreads);
+
+            bool isVisited(int vertex) const;
+
+            bool claim(int vertex);
+
+            template <typename Work>
+            void parallelFor(int count, int numberOfThreads, const Work& work);
+
+            shared_ptr<const CSRGraph> snapshot;
+            int startNodeIndex;
+            vector<int> distances;
+            vector<int> parents;
+            vector<int> levelOffsets;
+            vector<int> levelVertices;
+            vector<atomic<uint64_t>> visited; // One bit per vertex
+            vector<uint64_t> frontier; // Bits of the current level, only filled for bottom-up steps
+            vector<vector<int>> found; // Vertices each thread found in the current step
+            int numberOfBottomUpSteps;
+    };
+}
+
+// Inline in header because of templates.
+template <typename Work>
+void GraphModule::BreadthFirstSearch::parallelFor(int count, int numberOfThreads, const Work& work)
+{
+    // Blocks are whole words of the bitmaps, so no two threads write to the same word in a bottom-up step.
+    int blockSize = ((count + numberOfThreads - 1) / numberOfThreads + 63) / 64 * 64;
+    if (numberOfThreads == 1 || blockSize >= count)
+    {
+        work(0, 0, count);
+        return;
+    }
+    vector<thread> threads;
+    for (int t = 0; t < numberOfThreads && t * blockSize < count; t++)
+    {
+        threads.emplace_back(work, t, t * blockSize, min(count, (t + 1) * blockSize));
+    }
+    for (thread& worker : threads)
+    {
+        worker.join();
+    }
+}
+
+#endif
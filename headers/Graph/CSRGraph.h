@@ -0,0 +1,91 @@
+#ifndef CSRGraph_h
+#define CSRGraph_h
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/ArrayView.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class AbstractGraph;
+    class GraphStorage;
+    class GraphFile;
+
+    // Immutable compressed-sparse-row snapshot of a graph. Vertex ids are the 0-based node indexes
+    // and the arcs of row v are [offsets[v], offsets[v + 1]), kept in the insertion order of the graph.
+    // Undirected graphs store both directions of every edge, so their reverse rows are the forward ones.
+    // The rows are views, over arrays of the snapshot itself or straight over the sections of a mapped graph file.
+    class CSRGraph
+    {
+        public:
+            CSRGraph();
+
+            explicit CSRGraph(AbstractGraph& graph);
+
+            CSRGraph(const GraphStorage& storage, bool directed);
+
+            CSRGraph(int numberOfVertices, bool directed, vector<uint32_t> offsets, vector<uint32_t> targets, vector<float> weights);
+
+            explicit CSRGraph(shared_ptr<const GraphFile> file);
+
+            CSRGraph(const CSRGraph&) = delete;
+
+            CSRGraph& operator=(const CSRGraph&) = delete;
+
+            int getNumberOfVertices() const;
+
+            int getNumberOfArcs() const;
+
+            bool isDirected() const;
+
+            int outDegree(int vertex) const;
+
+            int inDegree(int vertex) const;
+
+            ArrayView<uint32_t> getOffsets() const;
+
+            ArrayView<uint32_t> getTargets() const;
+
+            ArrayView<float> getWeights() const;
+
+            ArrayView<uint32_t> getReverseOffsets() const;
+
+            ArrayView<uint32_t> getSources() const;
+
+            ArrayView<float> getReverseWeights() const;
+
+            // Hash of the direction, the rows and the weights. Files computed from a snapshot store it, so a file is only
+            // used with the graph it was computed for.
+            uint64_t getFingerprint() const;
+
+            ~CSRGraph();
+
+        private:
+            void buildReverse();
+
+            void viewArrays();
+
+            int numberOfVertices;
+            bool directed;
+            shared_ptr<const GraphFile> file; // Mapping the views point into, null when they point into the arrays below
+            ArrayView<uint32_t> offsetsView;
+            ArrayView<uint32_t> targetsView;
+            ArrayView<float> weightsView;
+            ArrayView<uint32_t> reverseOffsetsView; // The forward rows again for undirected graphs
+            ArrayView<uint32_t> sourcesView;
+            ArrayView<float> reverseWeightsView;
+            vector<uint32_t> offsets;
+            vector<uint32_t> targets;
+            vector<float> weights;
+            vector<uint32_t> reverseOffsets; // Only filled for directed graphs
+            vector<uint32_t> sources;
+            vector<float> reverseWeights;
+    };
+}
+
+#endif
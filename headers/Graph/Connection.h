@@ -5,17 +5,27 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <cstdint>
 
 using namespace std;
 
 namespace GraphModule
 {
     class Node;
+    class GraphStorage;
 
+    // Handle to a connection record in the GraphStorage of a graph. It shares the storage, so it stays valid after the graph
+    // itself is gone.
     class Connection
     {
         public:
-            Connection(float weight, weak_ptr<Node> startNode, weak_ptr<Node> endNode, bool goesBothWays);
+            Connection();
+
+            Connection(shared_ptr<GraphStorage> storage, uint32_t id);
+
+            bool isValid();
+
+            uint32_t getId();
 
             float getWeight();
             shared_ptr<Node> getStartNode();
@@ -30,10 +40,8 @@ namespace GraphModule
             ~Connection();
 
         private:
-            float weight;
-            weak_ptr<Node> startNode;
-            weak_ptr<Node> endNode;
-            bool goesBothWays;
+            shared_ptr<GraphStorage> storage;
+            uint32_t id;
     };
 }
 
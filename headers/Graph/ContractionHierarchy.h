@@ -0,0 +1,88 @@
+#ifndef ContractionHierarchy_h
+#define ContractionHierarchy_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+
+#include "Graph/IndexedHeap.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // Contraction hierarchy over a snapshot, for repeated point-to-point queries on a graph that does not change.
+    // Vertices are contracted in rounds of independent sets ordered by edge difference. Each round runs the witness
+    // searches of its vertices on all cores, then adds the shortcuts that no witness path makes unnecessary.
+    // Every arc and shortcut ends up stored once, at its endpoint of lower rank: upward rows hold the arcs leaving a vertex
+    // towards higher ranks and downward rows hold the arcs entering it from higher ranks. A query is a bidirectional
+    // Dijkstra that only goes up, and shortcuts are unpacked through the vertex they bypass.
+    // Weights are truncated to int as in dijkstra. The hierarchy can be saved and loaded back without preprocessing.
+    class ContractionHierarchy
+    {
+        public:
+            static constexpr uint32_t VERSION = 2;
+
+            explicit ContractionHierarchy(const CSRGraph& snapshot);
+
+            explicit ContractionHierarchy(const string& filePath);
+
+            void save(const string& filePath) const;
+
+            tuple<int, vector<int>> shortestPath(int startNodeIndex, int endNodeIndex);
+
+            int getNumberOfVertices() const;
+
+            // Whether the hierarchy was computed for a graph with the same arcs and weights as the snapshot.
+            bool belongsTo(const CSRGraph& snapshot) const;
+
+            int getNumberOfShortcuts() const;
+
+            int getNumberOfSettledVertices() const;
+
+            const vector<uint32_t>& getRanks() const;
+
+            ~ContractionHierarchy();
+
+        private:
+            struct Arc
+            {
+                uint32_t vertex; // Head of an upward arc, tail of a downward arc
+                int32_t weight;
+                int32_t middle; // Vertex bypassed by a shortcut, -1 for an arc of the graph
+            };
+
+            void contract(const CSRGraph& snapshot);
+
+            void prepareQueries();
+
+            const Arc& findArc(int from, int to) const;
+
+            void unpack(int from, int to, int middle, vector<int>& path) const;
+
+            int numberOfVertices;
+            int numberOfShortcuts;
+            int numberOfGraphArcs;
+            uint64_t graphFingerprint; // CSRGraph::getFingerprint of the snapshot it was computed for
+            vector<uint32_t> ranks; // Contraction order, the vertex contracted first has rank 0
+            vector<uint32_t> upwardOffsets;
+            vector<Arc> upwardArcs;
+            vector<uint32_t> downwardOffsets;
+            vector<Arc> downwardArcs;
+
+            // Query state, stamped per query as in BidirectionalDijkstra
+            vector<IndexedHeap<int>> heaps;
+            vector<int> distances[2];
+            vector<int> parents[2];
+            vector<int> parentMiddles[2];
+            vector<uint32_t> reachedStamps[2];
+            uint32_t query;
+            int numberOfSettledVertices;
+    };
+}
+
+#endif
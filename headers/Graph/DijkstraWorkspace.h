@@ -0,0 +1,59 @@
+#ifndef DijkstraWorkspace_h
+#define DijkstraWorkspace_h
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/IndexedHeap.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // State of one single-source Dijkstra, allocated once per snapshot and reused by every query after it. Distances and
+    // parents are only valid where the stamp of a vertex is the current query, so starting a query touches nothing and
+    // a query only costs the vertices it reaches. Weights are truncated to int and distances from 1000000 on are never
+    // stored, both as in dijkstra, whose results these are.
+    class DijkstraWorkspace
+    {
+        public:
+            static constexpr int INFINITE_DISTANCE = 1000000;
+
+            explicit DijkstraWorkspace(shared_ptr<const CSRGraph> snapshot);
+
+            void run(int startNodeIndex);
+
+            bool isReached(int vertex) const;
+
+            // 1000000 and -1 for vertices the last query did not reach.
+            int getDistance(int vertex) const;
+
+            int getParent(int vertex) const;
+
+            // Vertices reached by the last query, in the order they were settled.
+            const vector<int>& getSettled() const;
+
+            // Writes the distances and parents of every vertex, the D and A of dijkstra, into rows of V entries.
+            void copyTo(int* distances, int* parents) const;
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~DijkstraWorkspace();
+
+        private:
+            shared_ptr<const CSRGraph> snapshot;
+            IndexedHeap<int> heap;
+            vector<int> distances;
+            vector<int> parents;
+            vector<uint32_t> reachedStamps; // A vertex is reached when its stamp is the current query
+            vector<uint32_t> settledStamps;
+            vector<int> settled;
+            uint32_t query;
+    };
+}
+
+#endif
@@ -5,9 +5,11 @@
 #include <vector>
 #include <string>
 #include <list>
-#include <stack>
 #include <memory>
+#include <tuple>
+#include <cstdint>
 #include "Graph/AbstractGraph.h"
+#include "Graph/StronglyConnectedComponents.h"
 
 using namespace std;
 
@@ -15,6 +17,8 @@ namespace GraphModule
 {
     class Node;
     class Connection;
+    class CSRGraph;
+    class ContractionHierarchy;
 
     class DirectedGraph : public AbstractGraph
     {
@@ -23,39 +27,63 @@ namespace GraphModule
         
             int getDegreeOfNode(int nodeKey) override;
 
+            bool isDirected() override;
+
             int getInDegreeOfNode(int nodeKey);
 
             int getOutDegreeOfNode(int nodeKey);
 
-            void stronglyConnectedComponents();
+            vector<int> degreeSequence() override;
+
+            vector<int> inDegreeSequence();
 
-            void DFS(int v, bool C[], stack<int> &Stack);
+            vector<int> outDegreeSequence();
 
-            void DFSVisit(int v, bool C[]);
+            StronglyConnectedComponents stronglyConnectedComponents(bool withCondensation = false);
 
-            unique_ptr<DirectedGraph> BuildTransposedGraph();
+            // One line per component, in topological order of the condensation, with the vertices of each in ascending order.
+            void printStronglyConnectedComponents(const StronglyConnectedComponents& components);
 
             vector<shared_ptr<Node>> topologicalSorting();
 
-            void DFSVisitTopologicalSorting(int v, vector<bool> &C, vector<int> &F, vector<int> &T, vector<shared_ptr<Node>> &O, int &time);
+            void DFSVisitTopologicalSorting(const CSRGraph &snapshot, int v, vector<bool> &C, vector<int> &F, vector<int> &T, vector<int> &O, int &time);
 
             void printTopologicalSorting(const vector<shared_ptr<Node>> &O);
 
             void addArc(const shared_ptr<Node> &startNode, const shared_ptr<Node> &endNode, float weight);
 
+            // Adds the arcs of CSR rows over the current vertices, keeping the order of every row.
+            void addConnections(const uint32_t* offsets, const uint32_t* targets, const float* weights);
+
             int edmondsKarp(int beginNodeIndex, int endNodeIndex);
 
-            int BFS(int beginNodeIndex, int endNodeIndex, int parent[]);
+            int BFS(int beginNodeIndex, int endNodeIndex, vector<int> &parentArc);
 
             void printEdmontsKarp(int max_flow);
 
+            // Contracts the current snapshot the first time, and again after the graph changes.
+            const shared_ptr<ContractionHierarchy>& getContractionHierarchy();
+
+            // Uses a hierarchy loaded from disk for the current snapshot. It must have been computed for the same arcs and weights.
+            void setContractionHierarchy(shared_ptr<ContractionHierarchy> hierarchy);
+
+            tuple<int, vector<int>> contractedShortestPath(int startNodeIndex, int endNodeIndex);
+
             ~DirectedGraph() override;
 
         private:
+            void loadConnections(const GraphFile& file) override;
+
             int numberOfArcs;
-            vector<shared_ptr<Connection>> arcs;
-            list<int> *adj;
-            vector<vector<float>> residualNetwork; // Residual Graph Adjacency matrix for edmondsKarp
+
+            // Residual network for edmondsKarp: every arc of the snapshot plus a zero capacity twin, grouped by tail
+            vector<uint32_t> residualOffsets;
+            vector<uint32_t> residualTargets;
+            vector<uint32_t> residualTwins;
+            vector<float> residualCapacities;
+
+            shared_ptr<ContractionHierarchy> hierarchy;
+            shared_ptr<const CSRGraph> hierarchySnapshot; // Snapshot the hierarchy stands for
     };
 }
 
@@ -0,0 +1,235 @@
+#ifndef DistanceMatrix_h
+#define DistanceMatrix_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class MappedFile;
+
+    enum class DistanceType : uint32_t
+    {
+        INT32, // Weights truncated to int as in dijkstra, infinity 1000000
+        FLOAT32, // Fractional weights kept, infinity is the float infinity
+        UINT16 // Half the memory for non-negative weights, infinity 65535, which longer distances saturate to
+    };
+
+    // Element type of a distance matrix: its infinity and an addition that keeps infinity infinite.
+    template <typename Distance>
+    struct DistanceTraits;
+
+    template <>
+    struct DistanceTraits<int32_t>
+    {
+        static constexpr DistanceType TYPE = DistanceType::INT32;
+        static constexpr int32_t INFINITE = 1000000;
+
+        // Sums past 1000000 never win a min against a cell that is at most 1000000, so no clamp is needed.
+        static int32_t add(int32_t first, int32_t second)
+        {
+            return first + second;
+        }
+    };
+
+    template <>
+    struct DistanceTraits<float>
+    {
+        static constexpr DistanceType TYPE = DistanceType::FLOAT32;
+        static constexpr float INFINITE = numeric_limits<float>::infinity();
+
+        static float add(float first, float second)
+        {
+            return first + second;
+        }
+    };
+
+    template <>
+    struct DistanceTraits<uint16_t>
+    {
+        static constexpr DistanceType TYPE = DistanceType::UINT16;
+        static constexpr uint16_t INFINITE = UINT16_MAX;
+
+        // Wrapped sums come out below the first term. Written this way it compiles to one saturating vector add.
+        static uint16_t add(uint16_t first, uint16_t second)
+        {
+            uint16_t sum = first + second;
+            return sum < first ? INFINITE : sum;
+        }
+    };
+
+    // Distances between all pairs of vertices in one flat row-major buffer, padded to whole tiles of the blocked
+    // Floyd-Warshall and aligned to a cache line, so the kernel runs in place and nothing is copied afterwards.
+    // The optional next-hop matrix holds the vertex after i on a shortest path from i to j, in 16 bits while the vertex
+    // ids fit and in 32 otherwise. Both live on the heap or in a file mapped into memory, which only pages in what is
+    // touched and can be opened again by a later run instead of computing the matrix again.
+    class DistanceMatrix
+    {
+        public:
+            static constexpr uint32_t VERSION = 2;
+
+            static constexpr int NO_HOP = -1;
+
+            DistanceMatrix(int numberOfVertices, DistanceType type = DistanceType::INT32, bool withNextHops = false);
+
+            // Backed by filePath, which is created, or replaced, at the size of the matrix. On the heap when it is empty.
+            DistanceMatrix(int numberOfVertices, DistanceType type, bool withNextHops, const string& filePath);
+
+            // Maps a matrix written by an earlier run, read-only.
+            explicit DistanceMatrix(const string& filePath);
+
+            DistanceMatrix(const DistanceMatrix&) = delete;
+
+            DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+
+            DistanceMatrix(DistanceMatrix&& other) noexcept;
+
+            DistanceMatrix& operator=(DistanceMatrix&& other) noexcept;
+
+            // Every distance infinite and every next hop missing, except on the diagonal, where a vertex reaches itself at 0.
+            void reset();
+
+            int getNumberOfVertices() const;
+
+            DistanceType getType() const;
+
+            int getStride() const;
+
+            uint64_t getGraphFingerprint() const;
+
+            // Records the CSRGraph::getFingerprint of the graph once the matrix holds its distances, in the header too
+            // when backed by a file. A file left by a run that did not finish keeps 0 and matches no graph.
+            void setGraphFingerprint(uint64_t fingerprint);
+
+            bool hasNextHops() const;
+
+            bool isReachable(int from, int to) const;
+
+            double getDistance(int from, int to) const;
+
+            void setDistance(int from, int to, double distance);
+
+            int getNextHop(int from, int to) const;
+
+            void setNextHop(int from, int to, int hop);
+
+            // Vertices of a shortest path from one vertex to another, both included, empty when there is none.
+            vector<int> path(int from, int to) const;
+
+            // The stride wide buffers themselves, for kernels. The element type has to be the one of the matrix.
+            template <typename Distance>
+            Distance* distances();
+
+            template <typename Distance>
+            const Distance* distances() const;
+
+            template <typename Hop>
+            Hop* nextHops();
+
+            template <typename Hop>
+            const Hop* nextHops() const;
+
+            int getNextHopWidth() const;
+
+            ~DistanceMatrix();
+
+        private:
+            void allocate(const string& filePath);
+
+            template <typename Distance>
+            void resetDistances();
+
+            template <typename Hop>
+            void resetNextHops();
+
+            void checkWritable() const;
+
+            int numberOfVertices;
+            int stride;
+            DistanceType type;
+            int distanceWidth; // Bytes per distance
+            int nextHopWidth; // Bytes per next hop, 0 without them
+            uint64_t graphFingerprint;
+            unique_ptr<char, void (*)(void*)> heapBuffer; // Empty when backed by a file
+            unique_ptr<MappedFile> file;
+            char* distanceData;
+            char* nextHopData;
+            bool readOnly; // Mapped from the file of an earlier run
+    };
+}
+
+// Inline in header because of templates.
+template <typename Distance>
+void GraphModule::DistanceMatrix::resetDistances()
+{
+    // Padding cells stay infinite too, so they never shorten anything in the kernel.
+    Distance* cells = this->distances<Distance>();
+    fill(cells, cells + static_cast<size_t>(this->stride) * this->stride, DistanceTraits<Distance>::INFINITE);
+    for (int i = 0; i < this->numberOfVertices; i++)
+    {
+        cells[static_cast<size_t>(i) * this->stride + i] = 0;
+    }
+}
+
+template <typename Hop>
+void GraphModule::DistanceMatrix::resetNextHops()
+{
+    Hop* cells = this->nextHops<Hop>();
+    fill(cells, cells + static_cast<size_t>(this->stride) * this->stride, numeric_limits<Hop>::max());
+    for (int i = 0; i < this->numberOfVertices; i++)
+    {
+        cells[static_cast<size_t>(i) * this->stride + i] = i;
+    }
+}
+
+template <typename Distance>
+Distance* GraphModule::DistanceMatrix::distances()
+{
+    if (DistanceTraits<Distance>::TYPE != this->type)
+    {
+        throw logic_error("The distance matrix holds another element type");
+    }
+    this->checkWritable();
+    return reinterpret_cast<Distance*>(this->distanceData);
+}
+
+template <typename Distance>
+const Distance* GraphModule::DistanceMatrix::distances() const
+{
+    if (DistanceTraits<Distance>::TYPE != this->type)
+    {
+        throw logic_error("The distance matrix holds another element type");
+    }
+    return reinterpret_cast<const Distance*>(this->distanceData);
+}
+
+template <typename Hop>
+Hop* GraphModule::DistanceMatrix::nextHops()
+{
+    if (static_cast<int>(sizeof(Hop)) != this->nextHopWidth)
+    {
+        throw logic_error("The distance matrix holds no next hops of this width");
+    }
+    this->checkWritable();
+    return reinterpret_cast<Hop*>(this->nextHopData);
+}
+
+template <typename Hop>
+const Hop* GraphModule::DistanceMatrix::nextHops() const
+{
+    if (static_cast<int>(sizeof(Hop)) != this->nextHopWidth)
+    {
+        throw logic_error("The distance matrix holds no next hops of this width");
+    }
+    return reinterpret_cast<const Hop*>(this->nextHopData);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef EdgeIndex_h
+#define EdgeIndex_h
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class GraphStorage;
+
+    // Per-vertex sorted adjacency that answers "which connection goes from u to v" with a binary search over the row of u.
+    // Rows are sorted by (end node, connection id), so parallel connections resolve to the one inserted first.
+    class EdgeIndex
+    {
+        public:
+            explicit EdgeIndex(const GraphStorage& storage);
+
+            uint32_t find(uint32_t startNode, uint32_t endNode) const;
+
+            ~EdgeIndex();
+
+        private:
+            vector<uint32_t> offsets;
+            vector<uint32_t> endNodes;
+            vector<uint32_t> connections;
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef GraphFile_h
+#define GraphFile_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class AbstractGraph;
+    class DirectedGraph;
+    class UndirectedGraph;
+    class MappedFile;
+
+    // Binary snapshot of a graph, read through a memory map. The file is a fixed header followed by 8-byte aligned
+    // sections in host byte order: the CSR offsets, targets and weights, the reverse rows of a directed graph or the
+    // bipartition sides of the vertices of an undirected one, then optionally the names (offsets into a character
+    // table) and the x, y coordinates of every vertex. Vertex i is the node numbered i + 1.
+    // The accessors point straight into the mapping, so opening a file costs a header check and one pass over the
+    // arrays to bound them, and no parsing. A graph loaded from it keeps reading from the mapping.
+    class GraphFile
+    {
+        public:
+            static constexpr uint32_t VERSION = 2;
+
+            explicit GraphFile(const string& filePath);
+
+            GraphFile(const GraphFile&) = delete;
+
+            GraphFile& operator=(const GraphFile&) = delete;
+
+            static bool isGraphFile(const string& filePath);
+
+            static void write(DirectedGraph& graph, const string& filePath);
+
+            static void write(UndirectedGraph& graph, const string& filePath);
+
+            bool isDirected() const;
+
+            uint32_t getNumberOfVertices() const;
+
+            uint32_t getNumberOfArcs() const;
+
+            const uint32_t* getOffsets() const;
+
+            const uint32_t* getTargets() const;
+
+            const float* getWeights() const;
+
+            // Rows of the arcs entering every vertex, null for undirected graphs.
+            const uint32_t* getReverseOffsets() const;
+
+            const uint32_t* getSources() const;
+
+            const float* getReverseWeights() const;
+
+            // UndirectedGraph::DOMAIN and UndirectedGraph::CONTRADOMAIN bits of every vertex, null for directed graphs.
+            const uint8_t* getSides() const;
+
+            bool hasNames() const;
+
+            string getName(uint32_t vertex) const;
+
+            bool hasCoordinates() const;
+
+            const float* getCoordinates() const;
+
+            ~GraphFile();
+
+        private:
+            static constexpr uint32_t DIRECTED = 1; // Bits of Header::flags
+            static constexpr uint32_t NAMES = 2;
+            static constexpr uint32_t COORDINATES = 4;
+
+            struct Header
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t flags;
+                uint32_t numberOfVertices;
+                uint32_t numberOfArcs;
+                uint64_t offsetsPosition; // Byte positions of the sections from the start of the file
+                uint64_t targetsPosition;
+                uint64_t weightsPosition;
+                uint64_t nameOffsetsPosition;
+                uint64_t nameDataPosition;
+                uint64_t nameDataSize;
+                uint64_t coordinatesPosition;
+                uint64_t reverseOffsetsPosition;
+                uint64_t sourcesPosition;
+                uint64_t reverseWeightsPosition;
+                uint64_t sidesPosition;
+            };
+
+            static void write(AbstractGraph& graph, const string& filePath, const vector<uint8_t>& sides);
+
+            template <typename T>
+            const T* section(uint64_t position, uint64_t count) const;
+
+            const uint32_t* rows(uint64_t offsetsPosition, uint64_t targetsPosition, const uint32_t*& heads) const;
+
+            unique_ptr<MappedFile> file;
+            Header header;
+            const uint32_t* offsets;
+            const uint32_t* targets;
+            const float* weights;
+            const uint32_t* reverseOffsets;
+            const uint32_t* sources;
+            const float* reverseWeights;
+            const uint8_t* sides;
+            const uint32_t* nameOffsets;
+            const char* nameData;
+            const float* coordinates;
+    };
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef GraphStorage_h
+#define GraphStorage_h
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include "Graph/ArrayView.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    class Node;
+    class CSRGraph;
+    class EdgeIndex;
+    class ArcAttributes;
+    class GraphFile;
+
+    // Arena behind a graph. Nodes and connections are 32-bit ids into contiguous arrays, and each adjacency
+    // list is a chain of connection ids threaded through the connection records (forward star), so adding
+    // a connection only appends to a vector. Node and Connection objects are thin handles over these ids, which is why the
+    // graph owns its storage through a shared_ptr.
+    // A storage loaded from a graph file reads its snapshot, names and coordinates from the mapping. The connection records
+    // and the node handles are only built from it once something asks for them.
+    class GraphStorage : public enable_shared_from_this<GraphStorage>
+    {
+        public:
+            static constexpr uint32_t NONE = UINT32_MAX;
+
+            struct NodeRecord
+            {
+                uint32_t firstOutgoing;
+                uint32_t lastOutgoing;
+                uint32_t firstIncoming;
+                uint32_t lastIncoming;
+            };
+
+            struct ConnectionRecord
+            {
+                uint32_t startNode;
+                uint32_t endNode;
+                float weight;
+                uint32_t nextOutgoing; // Next connection leaving startNode
+                uint32_t nextIncoming; // Next connection entering endNode
+                bool goesBothWays;
+            };
+
+            GraphStorage();
+
+            void reserve(uint32_t numberOfNodes, uint32_t numberOfConnections);
+
+            // Takes the graph of a file into an empty storage.
+            void load(shared_ptr<const GraphFile> file);
+
+            uint32_t addNode(const shared_ptr<Node>& node);
+
+            uint32_t addConnection(uint32_t startNode, uint32_t endNode, float weight, bool goesBothWays);
+
+            uint32_t getNumberOfNodes() const;
+
+            uint32_t getNumberOfConnections() const;
+
+            const shared_ptr<Node>& getNode(uint32_t node);
+
+            const vector<shared_ptr<Node>>& getNodes();
+
+            string getName(uint32_t node) const;
+
+            uint32_t firstOutgoing(uint32_t node) const;
+
+            uint32_t firstIncoming(uint32_t node) const;
+
+            uint32_t nextOutgoing(uint32_t connection) const;
+
+            uint32_t nextIncoming(uint32_t connection) const;
+
+            uint32_t outDegree(uint32_t node) const;
+
+            uint32_t inDegree(uint32_t node) const;
+
+            const vector<uint32_t>& getOutDegrees() const;
+
+            const vector<uint32_t>& getInDegrees() const;
+
+            const ConnectionRecord* getConnectionRecords() const;
+
+            uint32_t getStartNode(uint32_t connection) const;
+
+            uint32_t getEndNode(uint32_t connection) const;
+
+            float getWeight(uint32_t connection) const;
+
+            bool getGoesBothWays(uint32_t connection) const;
+
+            void setWeight(uint32_t connection, float weight);
+
+            void setGoesBothWays(uint32_t connection, bool goesBothWays);
+
+            void setCoordinates(uint32_t node, float x, float y);
+
+            bool hasCoordinates() const;
+
+            ArrayView<float> getCoordinates() const;
+
+            void setArcAttributes(shared_ptr<ArcAttributes> arcAttributes);
+
+            const shared_ptr<ArcAttributes>& getArcAttributes() const;
+
+            shared_ptr<const CSRGraph> getSnapshot(bool directed);
+
+            uint32_t findConnection(uint32_t startNode, uint32_t endNode);
+
+            ~GraphStorage();
+
+        private:
+            void invalidate();
+
+            void buildConnections() const;
+
+            void buildNodes();
+
+            void releaseFile();
+
+            // Built from the file on first use, hence mutable, since reading them does not change the graph.
+            mutable vector<NodeRecord> nodeRecords;
+            mutable vector<ConnectionRecord> connectionRecords;
+            mutable vector<uint32_t> outDegrees; // Kept up to date by addConnection
+            mutable vector<uint32_t> inDegrees;
+            mutable bool connectionsPending; // The connections are still only the rows of the file
+            bool nodesPending;
+            shared_ptr<const GraphFile> file; // Holds the names and coordinates while set
+            vector<char> nameData; // Names of all nodes back to back, node i owns [nameOffsets[i], nameOffsets[i + 1])
+            vector<uint32_t> nameOffsets;
+            vector<float> coordinates; // x and y of node i at [2 * i, 2 * i + 1], empty when the input has no layout
+            shared_ptr<ArcAttributes> arcAttributes; // Attribute columns of the connections, null when the input had none
+            vector<shared_ptr<Node>> nodes; // One handle per node, shared with the callers of getNodes
+            shared_ptr<const CSRGraph> snapshot; // Built on demand, dropped whenever the storage changes
+            shared_ptr<const EdgeIndex> edgeIndex; // Built on the first findConnection, dropped when connections are added
+    };
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef IndexedHeap_h
+#define IndexedHeap_h
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Min-heap of Arity children per slot over the keys 0..numberOfKeys - 1, usually vertex ids. Entries are stored
+    // flat as (priority, key) pairs and a position array maps every key to its slot, so contains is O(1) and
+    // decreaseKey is a single O(log n) sift. Equal priorities come out in ascending key order.
+    template <typename Priority, int Arity = 4>
+    class IndexedHeap
+    {
+        static_assert(Arity >= 2, "A heap needs at least two children per slot");
+
+        public:
+            explicit IndexedHeap(int numberOfKeys);
+
+            bool empty() const;
+
+            int size() const;
+
+            bool contains(int key) const;
+
+            void push(int key, Priority priority);
+
+            void decreaseKey(int key, Priority priority);
+
+            void pushOrDecrease(int key, Priority priority);
+
+            int top() const;
+
+            Priority topPriority() const;
+
+            int pop();
+
+            Priority getPriority(int key) const;
+
+            void clear();
+
+        private:
+            static constexpr uint32_t ABSENT = UINT32_MAX;
+
+            struct Entry
+            {
+                Priority priority;
+                uint32_t key;
+            };
+
+            bool before(const Entry& first, const Entry& second) const;
+
+            void place(uint32_t slot, const Entry& entry);
+
+            void siftUp(uint32_t slot);
+
+            void siftDown(uint32_t slot);
+
+            vector<Entry> entries; // entries[0] is the minimum, the children of slot i are Arity * i + 1 .. Arity * i + Arity
+            vector<uint32_t> positions; // Slot of every key, ABSENT when the key is not in the heap
+    };
+}
+
+// Inline in header because of templates.
+template <typename Priority, int Arity>
+GraphModule::IndexedHeap<Priority, Arity>::IndexedHeap(int numberOfKeys)
+    : positions(numberOfKeys, ABSENT)
+{
+}
+
+template <typename Priority, int Arity>
+bool GraphModule::IndexedHeap<Priority, Arity>::empty() const
+{
+    return this->entries.empty();
+}
+
+template <typename Priority, int Arity>
+int GraphModule::IndexedHeap<Priority, Arity>::size() const
+{
+    return this->entries.size();
+}
+
+template <typename Priority, int Arity>
+bool GraphModule::IndexedHeap<Priority, Arity>::contains(int key) const
+{
+    return this->positions[key] != ABSENT;
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::push(int key, Priority priority)
+{
+    this->entries.push_back({priority, static_cast<uint32_t>(key)});
+    this->positions[key] = this->entries.size() - 1;
+    this->siftUp(this->entries.size() - 1);
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::decreaseKey(int key, Priority priority)
+{
+    uint32_t slot = this->positions[key];
+    this->entries[slot].priority = priority;
+    this->siftUp(slot);
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::pushOrDecrease(int key, Priority priority)
+{
+    if (this->contains(key))
+    {
+        this->decreaseKey(key, priority);
+    }
+    else
+    {
+        this->push(key, priority);
+    }
+}
+
+template <typename Priority, int Arity>
+int GraphModule::IndexedHeap<Priority, Arity>::top() const
+{
+    return this->entries.front().key;
+}
+
+template <typename Priority, int Arity>
+Priority GraphModule::IndexedHeap<Priority, Arity>::topPriority() const
+{
+    return this->entries.front().priority;
+}
+
+template <typename Priority, int Arity>
+int GraphModule::IndexedHeap<Priority, Arity>::pop()
+{
+    uint32_t key = this->entries.front().key;
+    this->positions[key] = ABSENT;
+
+    Entry last = this->entries.back();
+    this->entries.pop_back();
+    if (!this->entries.empty())
+    {
+        this->place(0, last);
+        this->siftDown(0);
+    }
+    return key;
+}
+
+template <typename Priority, int Arity>
+Priority GraphModule::IndexedHeap<Priority, Arity>::getPriority(int key) const
+{
+    return this->entries[this->positions[key]].priority;
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::clear()
+{
+    for (const Entry& entry : this->entries)
+    {
+        this->positions[entry.key] = ABSENT;
+    }
+    this->entries.clear();
+}
+
+template <typename Priority, int Arity>
+bool GraphModule::IndexedHeap<Priority, Arity>::before(const Entry& first, const Entry& second) const
+{
+    return first.priority < second.priority || (!(second.priority < first.priority) && first.key < second.key);
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::place(uint32_t slot, const Entry& entry)
+{
+    this->entries[slot] = entry;
+    this->positions[entry.key] = slot;
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::siftUp(uint32_t slot)
+{
+    // Moves the entry up by shifting its ancestors down, one write per level instead of a swap.
+    Entry entry = this->entries[slot];
+    while (slot > 0)
+    {
+        uint32_t parent = (slot - 1) / Arity;
+        if (!this->before(entry, this->entries[parent]))
+        {
+            break;
+        }
+        this->place(slot, this->entries[parent]);
+        slot = parent;
+    }
+    this->place(slot, entry);
+}
+
+template <typename Priority, int Arity>
+void GraphModule::IndexedHeap<Priority, Arity>::siftDown(uint32_t slot)
+{
+    Entry entry = this->entries[slot];
+    uint32_t size = this->entries.size();
+    while (true)
+    {
+        uint32_t firstChild = Arity * slot + 1;
+        if (firstChild >= size)
+        {
+            break;
+        }
+        uint32_t lastChild = firstChild + Arity < size ? firstChild + Arity : size;
+        uint32_t smallest = firstChild;
+        for (uint32_t child = firstChild + 1; child < lastChild; child++)
+        {
+            if (this->before(this->entries[child], this->entries[smallest]))
+            {
+                smallest = child;
+            }
+        }
+        if (!this->before(this->entries[smallest], entry))
+        {
+            break;
+        }
+        this->place(slot, this->entries[smallest]);
+        slot = smallest;
+    }
+    this->place(slot, entry);
+}
+
+#endif
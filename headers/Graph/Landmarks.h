@@ -0,0 +1,70 @@
+#ifndef Landmarks_h
+#define Landmarks_h
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    enum class LandmarkSelection
+    {
+        FARTHEST, // Each landmark is the vertex farthest from the ones already chosen
+        AVOID // Each landmark is the leaf of the shortest path tree region the current landmarks bound worst
+    };
+
+    // Distance tables of a few landmark vertices, for A* lower bounds by the triangle inequality (ALT). For every
+    // vertex v the table keeps d(L, v) and, on directed graphs, d(v, L) for each landmark L, stored side by side so a
+    // bound reads one short row per vertex. Undirected graphs keep a single table since both are the same.
+    // Landmarks are chosen one after another, then the remaining tables are filled by parallel Dijkstra runs.
+    // Weights are truncated to int as in dijkstra. Unreachable entries hold INT32_MAX rather than the 1000000 of dijkstra,
+    // since a bound taken from a capped distance would not be a lower bound.
+    class Landmarks
+    {
+        public:
+            static constexpr uint32_t VERSION = 2;
+
+            static constexpr int32_t UNREACHABLE = INT32_MAX;
+
+            Landmarks(shared_ptr<const CSRGraph> snapshot, int numberOfLandmarks, LandmarkSelection selection = LandmarkSelection::FARTHEST);
+
+            Landmarks(shared_ptr<const CSRGraph> snapshot, const vector<int>& landmarks);
+
+            // Reads tables saved for a graph with the same arcs and weights as the snapshot, any other file is refused.
+            Landmarks(shared_ptr<const CSRGraph> snapshot, const string& filePath);
+
+            void save(const string& filePath) const;
+
+            int lowerBound(int vertex, int target) const;
+
+            int getNumberOfLandmarks() const;
+
+            const vector<int>& getLandmarks() const;
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~Landmarks();
+
+        private:
+            void fillTables(bool forward, bool backward);
+
+            void fillTable(vector<int32_t>& table, int landmark, bool forward);
+
+            int selectFarthest() const;
+
+            int selectAvoiding(int root);
+
+            shared_ptr<const CSRGraph> snapshot;
+            vector<int> landmarks;
+            vector<int32_t> fromLandmarks; // d(landmarks[i], v) at [v * k + i]
+            vector<int32_t> toLandmarks; // d(v, landmarks[i]) at [v * k + i], empty for undirected graphs
+    };
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Memory map of a whole file, read-only, or read-write over a file created at a given size, whose writes go straight to
+    // the file. The mapping lives as long as the object, which cannot be copied.
+    class MappedFile
+    {
+        public:
+            explicit MappedFile(const string& filePath);
+
+            MappedFile(const string& filePath, size_t size);
+
+            MappedFile(const MappedFile&) = delete;
+
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const char* data() const;
+
+            char* writableData();
+
+            size_t size() const;
+
+            const string& getPath() const;
+
+            ~MappedFile();
+
+        private:
+            string filePath;
+            char* mappedData;
+            size_t mappedSize;
+            bool writable;
+    };
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef MultiSourceBFS_h
+#define MultiSourceBFS_h
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    // BFS from up to 256 sources at once (MS-BFS). Every vertex keeps one bit per source of the batch for the sources
+    // that have seen it and for those whose frontier holds it, so one pass over the arcs advances every search of the
+    // batch by a level. Batches of 64 sources or fewer use one word per vertex, larger ones up to four. Small frontiers
+    // push their bits along their arcs. Large ones are pulled by every vertex from its in-neighbours, which writes
+    // nothing shared and is split over the cores. Sources past 256 are run in further batches.
+    // Hop distances come out as rows of V entries per source, 1000000 where unreachable as in BFS, or are folded into
+    // per-source statistics without a matrix.
+    class MultiSourceBFS
+    {
+        public:
+            static constexpr int MAXIMUM_BATCH = 256;
+
+            struct Statistics
+            {
+                int eccentricity; // Largest hop distance to a reached vertex
+                int numberOfReached; // Vertices reached, the source included
+                long long totalDistance; // Sum of the hop distances to the reached vertices
+                double closeness; // (numberOfReached - 1) / totalDistance, 0 when nothing else is reached
+            };
+
+            explicit MultiSourceBFS(shared_ptr<const CSRGraph> snapshot);
+
+            // Row i, at i * V, holds the hop distances from sources[i].
+            vector<int> hopDistances(const vector<int>& sources);
+
+            vector<Statistics> statistics(const vector<int>& sources);
+
+            const shared_ptr<const CSRGraph>& getSnapshot() const;
+
+            ~MultiSourceBFS();
+
+        private:
+            static constexpr int INFINITE_DISTANCE = 1000000; // Same infinity as BFS
+            static constexpr int ALPHA = 14; // Pull once the frontier has more than 1 / ALPHA of the arcs
+            static constexpr int PARALLEL_GRAIN = 16384; // Pull steps over fewer vertices run on the calling thread
+
+            template <int Words>
+            struct Lanes
+            {
+                uint64_t bits[Words];
+            };
+
+            // Calls found(thread, i, vertex, level) once for every source i of the batch and every vertex it reaches.
+            template <typename Found>
+            void run(const vector<int>& sources, int numberOfThreads, const Found& found);
+
+            template <int Words, typename Found>
+            void runBatch(const int* sources, int first, int count, int numberOfThreads, const Found& found);
+
+            shared_ptr<const CSRGraph> snapshot;
+    };
+}
+
+// Inline in header because of templates.
+template <typename Found>
+void GraphModule::MultiSourceBFS::run(const vector<int>& sources, int numberOfThreads, const Found& found)
+{
+    for (size_t first = 0; first < sources.size(); first += MAXIMUM_BATCH)
+    {
+        int count = min(sources.size() - first, static_cast<size_t>(MAXIMUM_BATCH));
+        if (count <= 64)
+        {
+            this->runBatch<1>(sources.data() + first, first, count, numberOfThreads, found);
+        }
+        else if (count <= 128)
+        {
+            this->runBatch<2>(sources.data() + first, first, count, numberOfThreads, found);
+        }
+        else
+        {
+            this->runBatch<4>(sources.data() + first, first, count, numberOfThreads, found);
+        }
+    }
+}
+
+template <int Words, typename Found>
+void GraphModule::MultiSourceBFS::runBatch(const int* sources, int first, int count, int numberOfThreads, const Found& found)
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> targets = this->snapshot->getTargets();
+    ArrayView<uint32_t> reverseOffsets = this->snapshot->getReverseOffsets();
+    ArrayView<uint32_t> reverseSources = this->snapshot->getSources();
+    long long numberOfArcs = this->snapshot->getNumberOfArcs();
+
+    // Bits past the batch start out seen, so a vertex every source has seen is all ones and skipped as a whole.
+    Lanes<Words> all;
+    for (int w = 0; w < Words; w++)
+    {
+        int lanes = min(64, max(0, count - 64 * w));
+        all.bits[w] = lanes == 64 ? ~0ULL : (1ULL << lanes) - 1;
+    }
+    Lanes<Words> none = {};
+    vector<Lanes<Words>> seen(numberOfVertices);
+    vector<Lanes<Words>> visit(numberOfVertices, none);
+    vector<Lanes<Words>> next(numberOfVertices, none);
+    for (int v = 0; v < numberOfVertices; v++)
+    {
+        for (int w = 0; w < Words; w++)
+        {
+            seen[v].bits[w] = ~all.bits[w];
+        }
+    }
+    auto isEmpty = [](const Lanes<Words>& lanes)
+    {
+        uint64_t any = 0;
+        for (int w = 0; w < Words; w++)
+        {
+            any |= lanes.bits[w];
+        }
+        return any == 0;
+    };
+    vector<int> frontier;
+    for (int i = 0; i < count; i++)
+    {
+        int s = sources[i];
+        if (isEmpty(visit[s]))
+        {
+            frontier.push_back(s);
+        }
+        seen[s].bits[i >> 6] |= 1ULL << (i & 63);
+        visit[s].bits[i >> 6] |= 1ULL << (i & 63);
+        found(0, first + i, s, 0);
+    }
+
+    // Keeps the bits of next that are new to v as its frontier of the coming level and reports them.
+    auto settle = [&](int t, int v, int level)
+    {
+        bool reached = false;
+        for (int w = 0; w < Words; w++)
+        {
+            uint64_t fresh = next[v].bits[w] & ~seen[v].bits[w];
+            seen[v].bits[w] |= fresh;
+            next[v].bits[w] = fresh;
+            reached = reached || fresh != 0;
+            while (fresh != 0)
+            {
+                found(t, first + 64 * w + __builtin_ctzll(fresh), v, level);
+                fresh &= fresh - 1;
+            }
+        }
+        return reached;
+    };
+
+    // Next is all clear before every step and holds the coming frontier after it.
+    vector<vector<int>> reached(numberOfThreads);
+    for (int level = 1; !frontier.empty(); level++)
+    {
+        long long frontierArcs = 0;
+        for (int u : frontier)
+        {
+            frontierArcs += offsets[u + 1] - offsets[u];
+        }
+
+        if (frontierArcs * ALPHA > numberOfArcs)
+        {
+            // Pull: every vertex not yet seen by all gathers the frontiers of its in-neighbours. Blocks are in vertex
+            // order, so the new frontier comes out sorted.
+            int threads = numberOfVertices < PARALLEL_GRAIN ? 1 : numberOfThreads;
+            int blockSize = (numberOfVertices + threads - 1) / threads;
+            auto pull = [&](int t)
+            {
+                for (int v = t * blockSize; v < min(numberOfVertices, (t + 1) * blockSize); v++)
+                {
+                    bool complete = true;
+                    for (int w = 0; w < Words; w++)
+                    {
+                        complete = complete && seen[v].bits[w] == ~0ULL;
+                    }
+                    if (complete)
+                    {
+                        continue;
+                    }
+                    Lanes<Words> gathered = none;
+                    for (uint32_t arc = reverseOffsets[v]; arc < reverseOffsets[v + 1]; arc++)
+                    {
+                        const Lanes<Words>& lanes = visit[reverseSources[arc]];
+                        for (int w = 0; w < Words; w++)
+                        {
+                            gathered.bits[w] |= lanes.bits[w];
+                        }
+                    }
+                    next[v] = gathered;
+                    if (settle(t, v, level))
+                    {
+                        reached[t].push_back(v);
+                    }
+                }
+            };
+            if (threads == 1)
+            {
+                pull(0);
+            }
+            else
+            {
+                vector<thread> workers;
+                for (int t = 0; t < threads; t++)
+                {
+                    workers.emplace_back(pull, t);
+                }
+                for (thread& worker : workers)
+                {
+                    worker.join();
+                }
+            }
+        }
+        else
+        {
+            // Push: the few frontier vertices hand their bits to their out-neighbours, then those are settled.
+            vector<int> touched;
+            for (int u : frontier)
+            {
+                for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+                {
+                    int v = targets[arc];
+                    if (isEmpty(next[v]))
+                    {
+                        touched.push_back(v);
+                    }
+                    for (int w = 0; w < Words; w++)
+                    {
+                        next[v].bits[w] |= visit[u].bits[w];
+                    }
+                }
+            }
+            for (int v : touched)
+            {
+                if (settle(0, v, level))
+                {
+                    reached[0].push_back(v);
+                }
+                else
+                {
+                    next[v] = none;
+                }
+            }
+        }
+
+        // The old frontier is the only part of visit that is set, so clearing it leaves next clear for the coming step.
+        visit.swap(next);
+        for (int u : frontier)
+        {
+            next[u] = none;
+        }
+        frontier.clear();
+        for (vector<int>& vertices : reached)
+        {
+            frontier.insert(frontier.end(), vertices.begin(), vertices.end());
+            vertices.clear();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef NeighbourRange_h
+#define NeighbourRange_h
+
+#include <iostream>
+#include <cstdint>
+
+#include "Graph/GraphStorage.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Element yielded by NeighbourRange, usable as `for (auto [v, w] : node->outNeighbours())`.
+    struct Neighbour
+    {
+        uint32_t vertex;
+        float weight;
+    };
+
+    // View over one adjacency chain of a GraphStorage. It walks the connection records in place, so iterating
+    // neither allocates nor touches a reference count. It is invalidated by any change to the graph and must not
+    // outlive it.
+    class NeighbourRange
+    {
+        public:
+            class Iterator
+            {
+                public:
+                    Iterator(const GraphStorage::ConnectionRecord* records, uint32_t connection, bool incoming);
+
+                    Neighbour operator*() const;
+
+                    Iterator& operator++();
+
+                    bool operator!=(const Iterator& other) const;
+
+                    bool operator==(const Iterator& other) const;
+
+                    uint32_t getConnection() const;
+
+                private:
+                    const GraphStorage::ConnectionRecord* records;
+                    uint32_t connection;
+                    bool incoming;
+            };
+
+            NeighbourRange();
+
+            NeighbourRange(const GraphStorage* storage, uint32_t node, bool incoming);
+
+            Iterator begin() const;
+
+            Iterator end() const;
+
+            uint32_t size() const;
+
+            bool empty() const;
+
+        private:
+            const GraphStorage::ConnectionRecord* records;
+            uint32_t first;
+            uint32_t count;
+            bool incoming;
+    };
+}
+
+// Inline in header so that a traversal compiles down to reads of the connection records.
+inline GraphModule::NeighbourRange::Iterator::Iterator(const GraphStorage::ConnectionRecord* records, uint32_t connection, bool incoming)
+    : records(records), connection(connection), incoming(incoming)
+{
+}
+
+inline GraphModule::Neighbour GraphModule::NeighbourRange::Iterator::operator*() const
+{
+    const GraphStorage::ConnectionRecord& record = this->records[this->connection];
+    return {this->incoming ? record.startNode : record.endNode, record.weight};
+}
+
+inline GraphModule::NeighbourRange::Iterator& GraphModule::NeighbourRange::Iterator::operator++()
+{
+    const GraphStorage::ConnectionRecord& record = this->records[this->connection];
+    this->connection = this->incoming ? record.nextIncoming : record.nextOutgoing;
+    return *this;
+}
+
+inline bool GraphModule::NeighbourRange::Iterator::operator!=(const Iterator& other) const
+{
+    return this->connection != other.connection;
+}
+
+inline bool GraphModule::NeighbourRange::Iterator::operator==(const Iterator& other) const
+{
+    return this->connection == other.connection;
+}
+
+inline uint32_t GraphModule::NeighbourRange::Iterator::getConnection() const
+{
+    return this->connection;
+}
+
+inline GraphModule::NeighbourRange::NeighbourRange()
+    : records(nullptr), first(GraphStorage::NONE), count(0), incoming(false)
+{
+}
+
+inline GraphModule::NeighbourRange::NeighbourRange(const GraphStorage* storage, uint32_t node, bool incoming)
+    : records(storage->getConnectionRecords()),
+      first(incoming ? storage->firstIncoming(node) : storage->firstOutgoing(node)),
+      count(incoming ? storage->inDegree(node) : storage->outDegree(node)),
+      incoming(incoming)
+{
+}
+
+inline GraphModule::NeighbourRange::Iterator GraphModule::NeighbourRange::begin() const
+{
+    return Iterator(this->records, this->first, this->incoming);
+}
+
+inline GraphModule::NeighbourRange::Iterator GraphModule::NeighbourRange::end() const
+{
+    return Iterator(this->records, GraphStorage::NONE, this->incoming);
+}
+
+inline uint32_t GraphModule::NeighbourRange::size() const
+{
+    return this->count;
+}
+
+inline bool GraphModule::NeighbourRange::empty() const
+{
+    return this->count == 0;
+}
+
+#endif
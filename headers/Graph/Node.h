@@ -5,6 +5,9 @@
 #include <vector> // Will perhaps be replaced by list if adds and removes are more common than reads. Vector is cache friendly.
 #include <tuple>
 #include <memory>
+#include <cstdint>
+
+#include "Graph/NeighbourRange.h"
 
 using namespace std;
 
@@ -12,7 +15,11 @@ namespace GraphModule
 {
 
     class Connection;
+    class GraphStorage;
 
+    // Handle to a node living in the GraphStorage of a graph. Until it is added to a graph it only holds its number and name.
+    // The storage owns its node handles, so a node only refers to it weakly: number and name stay readable once the graph
+    // is gone, anything that reaches for connections or neighbours then throws.
     class Node
     {
         public:
@@ -22,9 +29,16 @@ namespace GraphModule
 
             string getName();
 
-            vector<shared_ptr<Connection>> getConnections();
+            uint32_t getId();
+
+            void attach(const shared_ptr<GraphStorage>& storage, uint32_t id);
+
+            NeighbourRange outNeighbours();
+
+            NeighbourRange inNeighbours();
 
-            void addConnections(const vector<weak_ptr<Connection>>& connectionsToAdd);
+            // The accessors below keep their shared_ptr<Connection> form, each pointing to a handle over the storage record.
+            vector<shared_ptr<Connection>> getConnections();
 
             tuple<bool, shared_ptr<Connection>> getConnectionWith(const shared_ptr<Node>& NodeConnectedOnTheOtherEnd);
 
@@ -40,27 +54,22 @@ namespace GraphModule
 
             int numberOfOutgoingConnections();
 
-            void addConnection(const weak_ptr<Connection>& connectionToAdd);
-
-            void addIncomingConnection(const weak_ptr<Connection>& connectionToAdd);
-
-            void addOutgoingConnection(const weak_ptr<Connection>& connectionToAdd);
-
             vector<shared_ptr<Node>> getOutgoingNeighbours();
 
             vector<tuple<shared_ptr<Node>, shared_ptr<Connection>>> getOutgoingNeighboursWithConnection();
 
             vector<shared_ptr<Node>> getIncomingNeighbours();
 
-            ~Node();    
+            ~Node();
 
         private:
+            shared_ptr<GraphStorage> lockStorage() const;
+
             int number;
             string name;
-            vector<weak_ptr<Connection>> connections;
-            vector<weak_ptr<Connection>> incomingConnections;
-            vector<weak_ptr<Connection>> outgoingConnections;
+            weak_ptr<GraphStorage> storage;
+            uint32_t id;
     };
 }
 
-#endif 
+#endif
@@ -0,0 +1,84 @@
+#ifndef PredecessorPaths_h
+#define PredecessorPaths_h
+
+#include <iostream>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Paths out of one source read from a predecessor array, the A of dijkstra, deltaStepping and BFS, where the source
+    // and the vertices it does not reach have -1. A path is walked back from its target and reversed, in time linear
+    // in its length. Iterating goes through every target in order and builds each path only when it is reached, in a
+    // buffer the iterator reuses, so all V paths can be streamed without holding more than one. The view only points
+    // at the predecessors, which have to outlive it.
+    class PredecessorPaths
+    {
+        public:
+            // A target and the vertices from the source to it, both included, empty when the source does not reach it.
+            struct Route
+            {
+                int target;
+                vector<int> vertices;
+            };
+
+            class Iterator
+            {
+                public:
+                    using iterator_category = input_iterator_tag;
+                    using value_type = Route;
+                    using difference_type = ptrdiff_t;
+                    using pointer = const Route*;
+                    using reference = const Route&;
+
+                    Iterator(const PredecessorPaths* paths, int target);
+
+                    const Route& operator*() const;
+
+                    const Route* operator->() const;
+
+                    Iterator& operator++();
+
+                    bool operator==(const Iterator& other) const;
+
+                    bool operator!=(const Iterator& other) const;
+
+                private:
+                    void load();
+
+                    const PredecessorPaths* paths;
+                    Route route;
+            };
+
+            PredecessorPaths(const int* parents, int numberOfVertices, int source);
+
+            PredecessorPaths(const vector<int>& parents, int source);
+
+            int getSource() const;
+
+            int getNumberOfVertices() const;
+
+            bool hasPath(int target) const;
+
+            vector<int> path(int target) const;
+
+            // The same into a buffer of the caller, which is cleared first and keeps its capacity from path to path.
+            void path(int target, vector<int>& vertices) const;
+
+            Iterator begin() const;
+
+            Iterator end() const;
+
+            ~PredecessorPaths();
+
+        private:
+            const int* parents;
+            int numberOfVertices;
+            int source;
+    };
+}
+
+#endif
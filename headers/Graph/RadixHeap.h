@@ -0,0 +1,120 @@
+#ifndef RadixHeap_h
+#define RadixHeap_h
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Monotone priority queue for unsigned integer keys, as the distances of a Dijkstra with non-negative integer
+    // weights. Bucket i holds the keys whose highest bit differing from the last popped key is bit i - 1, so a push is
+    // one bit scan and every entry moves down at most 32 times. Keys pushed must not be below the last popped key.
+    // There is no decrease-key, callers push again and skip the stale entries.
+    template <typename Value>
+    class RadixHeap
+    {
+        public:
+            RadixHeap();
+
+            bool empty() const;
+
+            int size() const;
+
+            void push(uint32_t key, const Value& value);
+
+            pair<uint32_t, Value> pop();
+
+            void clear();
+
+        private:
+            static constexpr int NUMBER_OF_BUCKETS = 33;
+
+            static int bucketOf(uint32_t key, uint32_t last);
+
+            vector<pair<uint32_t, Value>> buckets[NUMBER_OF_BUCKETS];
+            uint32_t last; // Last popped key, every stored key is at least this
+            int numberOfEntries;
+    };
+}
+
+// Inline in header because of templates.
+template <typename Value>
+GraphModule::RadixHeap<Value>::RadixHeap()
+    : last(0), numberOfEntries(0)
+{
+}
+
+template <typename Value>
+bool GraphModule::RadixHeap<Value>::empty() const
+{
+    return this->numberOfEntries == 0;
+}
+
+template <typename Value>
+int GraphModule::RadixHeap<Value>::size() const
+{
+    return this->numberOfEntries;
+}
+
+template <typename Value>
+int GraphModule::RadixHeap<Value>::bucketOf(uint32_t key, uint32_t last)
+{
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+template <typename Value>
+void GraphModule::RadixHeap<Value>::push(uint32_t key, const Value& value)
+{
+    this->buckets[bucketOf(key, this->last)].emplace_back(key, value);
+    this->numberOfEntries++;
+}
+
+template <typename Value>
+pair<uint32_t, Value> GraphModule::RadixHeap<Value>::pop()
+{
+    if (this->buckets[0].empty())
+    {
+        // The minimum of the first non-empty bucket becomes the new last key and the bucket is spread below it.
+        int bucket = 1;
+        while (this->buckets[bucket].empty())
+        {
+            bucket++;
+        }
+        uint32_t minimum = this->buckets[bucket].front().first;
+        for (const pair<uint32_t, Value>& entry : this->buckets[bucket])
+        {
+            if (entry.first < minimum)
+            {
+                minimum = entry.first;
+            }
+        }
+        this->last = minimum;
+        for (const pair<uint32_t, Value>& entry : this->buckets[bucket])
+        {
+            this->buckets[bucketOf(entry.first, this->last)].push_back(entry);
+        }
+        this->buckets[bucket].clear();
+    }
+
+    pair<uint32_t, Value> entry = this->buckets[0].back();
+    this->buckets[0].pop_back();
+    this->numberOfEntries--;
+    return entry;
+}
+
+template <typename Value>
+void GraphModule::RadixHeap<Value>::clear()
+{
+    for (vector<pair<uint32_t, Value>>& bucket : this->buckets)
+    {
+        bucket.clear();
+    }
+    this->last = 0;
+    this->numberOfEntries = 0;
+}
+
+#endif
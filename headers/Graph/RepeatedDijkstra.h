@@ -0,0 +1,63 @@
+#ifndef RepeatedDijkstra_h
+#define RepeatedDijkstra_h
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+#include "Graph/IndexedHeap.h"
+#include "Graph/DistanceMatrix.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    // All pairs shortest paths by one Dijkstra from every vertex, about V * E log V against the V^3 of Floyd-Warshall,
+    // which is far less on sparse graphs. Sources are handed out to every core. Negative arcs are first removed by
+    // Johnson's reweighting, with Bellman-Ford potentials from a virtual source joined to every vertex. A negative
+    // cycle leaves no shortest paths to reweight, which hasNegativeCycle reports.
+    // Distances are summed in double, exact for the integer weights, and stored as the matrix stores them. A loop counts
+    // on the diagonal as it does in floydWarshall, so with non-negative integer weights the distances are the ones
+    // floydWarshall finds. Next hops come from the shortest path trees and may take another of two equal paths.
+    class RepeatedDijkstra
+    {
+        public:
+            // Rows of the graph with at most one arc per ordered pair of vertices.
+            RepeatedDijkstra(vector<uint32_t> offsets, vector<uint32_t> targets, vector<double> weights);
+
+            static bool isSparse(int numberOfVertices, size_t numberOfArcs);
+
+            bool hasNegativeCycle() const;
+
+            void run(DistanceMatrix& D) const;
+
+            ~RepeatedDijkstra();
+
+        private:
+            bool computePotentials();
+
+            // Distances, parents and settling order of one source, reused by a thread for all of its sources.
+            struct Sweep
+            {
+                vector<double> distances;
+                vector<int> parents;
+                vector<int> order;
+                vector<int> hops;
+                IndexedHeap<double> heap;
+
+                explicit Sweep(int numberOfVertices);
+            };
+
+            void sweep(int source, DistanceMatrix& D, Sweep& state) const;
+
+            int numberOfVertices;
+            vector<uint32_t> offsets;
+            vector<uint32_t> targets;
+            vector<double> weights;
+            vector<double> reducedWeights; // w(u, v) + h(u) - h(v), never negative
+            vector<double> potentials; // h, all 0 when no weight is negative
+            bool negativeCycle;
+    };
+}
+
+#endif
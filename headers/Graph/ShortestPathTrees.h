@@ -0,0 +1,53 @@
+#ifndef ShortestPathTrees_h
+#define ShortestPathTrees_h
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+#include "Graph/PredecessorPaths.h"
+
+using namespace std;
+
+namespace GraphModule
+{
+    // Shortest path trees of a batch of sources, one row of V distances and one of V parents per source, each kind in a
+    // single flat array so a batch is two allocations whatever its size. Row i holds the D and A dijkstra gives for
+    // the i-th source: 1000000 and -1 for vertices it does not reach, -1 as the parent of the source.
+    class ShortestPathTrees
+    {
+        public:
+            ShortestPathTrees(vector<int> sources, int numberOfVertices);
+
+            int getNumberOfTrees() const;
+
+            int getNumberOfVertices() const;
+
+            int getSource(int tree) const;
+
+            int getDistance(int tree, int vertex) const;
+
+            int getParent(int tree, int vertex) const;
+
+            const int* distanceRow(int tree) const;
+
+            const int* parentRow(int tree) const;
+
+            int* distanceRow(int tree);
+
+            int* parentRow(int tree);
+
+            // Paths of one tree, over its row of parents.
+            PredecessorPaths paths(int tree) const;
+
+            ~ShortestPathTrees();
+
+        private:
+            vector<int> sources;
+            int numberOfVertices;
+            vector<int> distances; // Row-major, sources x vertices
+            vector<int> parents;
+    };
+}
+
+#endif
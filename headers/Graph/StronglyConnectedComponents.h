@@ -0,0 +1,60 @@
+#ifndef StronglyConnectedComponents_h
+#define StronglyConnectedComponents_h
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace GraphModule
+{
+    class CSRGraph;
+
+    // Strongly connected components by Pearce's variant of Tarjan's algorithm, in one depth-first pass run on an explicit
+    // stack, so deep graphs cannot overflow the call stack. A single rindex array holds the DFS index of open vertices
+    // and the component of closed ones, with one root bit per vertex besides.
+    // Components are numbered in the order they close, which puts every arc between two components from the higher id
+    // to the lower one: id 0 has no way out and the last id is a topological first. The vertices of each component are
+    // stored together, and the condensation DAG can be built as components close, from the arcs of their vertices.
+    class StronglyConnectedComponents
+    {
+        public:
+            StronglyConnectedComponents(const CSRGraph& snapshot, bool withCondensation = false);
+
+            int getNumberOfComponents() const;
+
+            // Component id of every vertex.
+            const vector<int>& getComponents() const;
+
+            const vector<int>& getComponentSizes() const;
+
+            // The vertices of component c are componentVertices[componentOffsets[c], componentOffsets[c + 1]).
+            const vector<int>& getComponentOffsets() const;
+
+            const vector<int>& getComponentVertices() const;
+
+            bool hasCondensation() const;
+
+            // Rows of the condensation DAG, one per component, each target once. Empty unless it was asked for.
+            const vector<uint32_t>& getCondensationOffsets() const;
+
+            const vector<uint32_t>& getCondensationTargets() const;
+
+            ~StronglyConnectedComponents();
+
+        private:
+            void close(const CSRGraph& snapshot, int first);
+
+            bool withCondensation;
+            vector<int> components;
+            vector<int> componentSizes;
+            vector<int> componentOffsets;
+            vector<int> componentVertices;
+            vector<uint32_t> condensationOffsets;
+            vector<uint32_t> condensationTargets;
+            vector<int> lastSource; // Component that last added an arc to each component, to add every arc once
+    };
+}
+
+#endif
@@ -7,30 +7,45 @@
 #include <memory>
 #include <tuple>
 #include <list>
+#include <cstdint>
 
 #include "Graph/AbstractGraph.h"
+#include "Graph/DistanceMatrix.h"
 
 using namespace std;
 
-typedef pair<int, float> node_weight_pair; // node_weight_pair ==>  Integer Pair
-
 namespace GraphModule
 {
     class Node;
+    class BreadthFirstSearch;
+
+    // Engine behind allPairsShortestPaths. AUTOMATIC runs Floyd-Warshall on dense graphs and a Dijkstra from every
+    // vertex on sparse ones, falling back to Floyd-Warshall when a negative cycle rules out Johnson's reweighting.
+    enum class AllPairsEngine { AUTOMATIC, FLOYD_WARSHALL, REPEATED_DIJKSTRA };
     class Connection;
 
     class UndirectedGraph : public AbstractGraph
     {
         public:
+            static constexpr uint8_t IN_DOMAIN = 1; // Bits of getBipartitionSides
+            static constexpr uint8_t IN_CONTRADOMAIN = 2;
+
             UndirectedGraph();
 
             int getDegreeOfNode(int nodeKey) override;
 
+            vector<int> degreeSequence() override;
+
+            bool isDirected() override;
+
             void addEdge(const shared_ptr<Node>& node1, const shared_ptr<Node>& node2, float weight);
 
+
             tuple<vector<int>, vector<int>> BFS(int startNodeIndex);
 
-            void printBFS(vector<int> D);
+            void printBFS(const vector<int>& D);
+
+            void printBFS(const BreadthFirstSearch& search);
 
             vector<int> eulerianCycle(int startNodeIndex);
 
@@ -38,13 +53,19 @@ namespace GraphModule
 
             void printEulerianCycle(vector<int> Cycle);
 
-            tuple<vector<int>, vector<int>> dijkstra(int startNodeIndex);
+            void printDijkstra(int startNodeIndex, const vector<int>& D, const vector<int>& A);
 
-            void printDijkstra(int startNodeIndex, vector<int> D, vector<int> A);
+            DistanceMatrix floydWarshall(DistanceType type = DistanceType::INT32, bool withNextHops = false);
 
-            vector<vector<int>> floydWarshall();
+            // Fills a matrix the caller made, for instance one backed by a file.
+            void floydWarshall(DistanceMatrix& D);
 
-            void printFloydWarshall(vector<vector<int>> D);
+            DistanceMatrix allPairsShortestPaths(AllPairsEngine engine = AllPairsEngine::AUTOMATIC, DistanceType type = DistanceType::INT32,
+                                                 bool withNextHops = false);
+
+            void allPairsShortestPaths(DistanceMatrix& D, AllPairsEngine engine = AllPairsEngine::AUTOMATIC);
+
+            void printFloydWarshall(const DistanceMatrix& D);
 
             vector<int> prim();
 
@@ -54,6 +75,9 @@ namespace GraphModule
 
             void printColoring(vector<int>  colors);
 
+            // The sides every vertex is on, as first and as second endpoint of the edges as they were written.
+            vector<uint8_t> getBipartitionSides();
+
             void configureBipartiteGraph();
             
             tuple<int,  int*> hopcroftKarp();
@@ -67,18 +91,24 @@ namespace GraphModule
             ~UndirectedGraph() override;
 
         private:
+            void loadConnections(const GraphFile& file) override;
+
+            void collectArcs(vector<uint32_t>& offsets, vector<uint32_t>& targets, vector<float>& weights);
+
+            void addToBipartition(int n1, int n2);
+
             int numberOfEdges;
-            vector<shared_ptr<Connection>> edges;
-            list<pair<int, float> > *adj; //used for Prim
-            list<int> *color_adj; //used for Coloring
 
             // Varibles below used on hopcroftKarp
-            list<int> *adjacency;
+            vector<uint32_t> bipartiteOffsets; // Domain rows of the snapshot, targets mapped to 1..n
+            vector<int> bipartiteTargets;
             vector<int> domain;
             vector<int> contradomain;
+            vector<bool> inDomain; // Indexed by node number, replaces a linear search of domain on every edge
+            vector<bool> inContradomain;
             int m; // Domain size 
             int n; // Contra domain size
-            int *pairU, *pairV, *dist; //arrays for matches and distance
+            vector<int> pairU, pairV, dist; //arrays for matches and distance
     };
 }
 
@@ -5,11 +5,20 @@
 #include <memory>
 #include <fstream>
 #include <map>
+#include <chrono>
 
 #include "Graph/UndirectedGraph.h"
+#include "Graph/BreadthFirstSearch.h"
 #include "Graph/DirectedGraph.h"
 #include "Graph/Node.h"
+#include "Graph/GraphFile.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/ContractionHierarchy.h"
+#include "Graph/Landmarks.h"
+#include "Graph/DistanceMatrix.h"
 #include "Activities/Activities.h"
+#include "Activities/PajekLoader.h"
 
 using namespace std;
 using namespace filesystem;
@@ -61,10 +70,7 @@ void Activities::runA1(int question, const string& graphFile)
         cout << endl;
         cout << "Running BFS on vertex " << i << " in file " << graphFile << endl;
         i--;
-        tuple<vector<int>, vector<int>> BFSTuple = graph->BFS(i);
-        vector<int> D = get<0>(BFSTuple);
-        vector<int> A = get<1>(BFSTuple);
-        graph->printBFS(D);
+        graph->printBFS(graph->breadthFirstLevels(i));
     }
     else if (question == 3)
     {
@@ -97,8 +103,28 @@ void Activities::runA1(int question, const string& graphFile)
     else if (question == 5)
     {
         cout << "Floyd Warshall" << " in file " << graphFile << endl;
-        vector<vector<int>> D = graph->floydWarshall(); 
-        graph->printFloydWarshall(D);
+        // A matrix saved by ./Main distances is printed as it is when it holds the int32 distances of this very graph.
+        // Any other file, including one of an older version or of a run that did not finish, is computed again.
+        string matrixPath = distanceMatrixPath(graphFilePath);
+        unique_ptr<DistanceMatrix> saved;
+        if (filesystem::exists(matrixPath))
+        {
+            try
+            {
+                saved = make_unique<DistanceMatrix>(matrixPath);
+            }
+            catch (const invalid_argument&)
+            { // Left empty, the matrix is computed below
+            }
+        }
+        if (saved && saved->getType() == DistanceType::INT32 && saved->getGraphFingerprint() == graph->getSnapshot()->getFingerprint())
+        {
+            graph->printFloydWarshall(*saved);
+        }
+        else
+        {
+            graph->printFloydWarshall(graph->allPairsShortestPaths());
+        }
         cout << endl;
     }
 }
@@ -132,7 +158,7 @@ void Activities::runA2(int question, const string& graphFile)
         checkGraphKindFromInputFile(graphFilePath, "directed");
         auto directedGraph = buildGraph<DirectedGraph>(graphFilePath);
         cout << "Strongly Connected Components"<< endl;
-        directedGraph->stronglyConnectedComponents();
+        directedGraph->printStronglyConnectedComponents(directedGraph->stronglyConnectedComponents());
     }
 
     else if (question == 2)
@@ -219,167 +245,153 @@ void Activities::runA3(int question, const string& graphFile)
 
 void Activities::buildGraphFromInputFile(UndirectedGraph* graph, string inputFilePath)
 {
-    char* inputFilePathChar = &inputFilePath[0];
-
-    ifstream inputFile;
-    inputFile.open(inputFilePathChar, ios::in);
-
-    bool inputVertices = false;
-    bool inputEdges = false;
-
-    if (inputFile.is_open())
-    {   
-        string line;
-        while (getline(inputFile, line))
-        {
-            stringstream ss(line);
-            string token;
-            vector<string> tokens;
-            while (ss >> token)
-            {
-                tokens.push_back(token);
-            }
+    if (GraphFile::isGraphFile(inputFilePath))
+    {
+        buildGraphFromGraphFile(graph, inputFilePath);
+        return;
+    }
 
-            if (tokens[0] == "*vertices")
-            {
-                inputVertices = true;
-                continue;
-            }
+    PajekLoader loader(inputFilePath);
+    loader.build(graph);
+}
 
-            if (tokens[0] == "*edges")
-            {
-                inputVertices = false;
-                inputEdges = true;
-                continue;
-            }
+void Activities::buildGraphFromInputFile(DirectedGraph* graph, string inputFilePath)
+{
+    if (GraphFile::isGraphFile(inputFilePath))
+    {
+        buildGraphFromGraphFile(graph, inputFilePath);
+        return;
+    }
 
-            if (inputVertices)
-            {
-                int index = stoi(tokens[0]);
-                string name;
+    PajekLoader loader(inputFilePath);
+    loader.build(graph);
+}
 
-                for (long unsigned int i = 1; i < tokens.size() - 1; i++)
-                {
-                    name += tokens[i] + " ";
-                }
-                name += tokens[tokens.size() - 1];
+void Activities::buildGraphFromGraphFile(AbstractGraph* graph, const string& inputFilePath)
+{
+    graph->load(make_shared<const GraphFile>(inputFilePath));
+}
 
-                shared_ptr<Node> nodeSharedPtr = make_shared<Node>(index, name);
-                graph->addNode(nodeSharedPtr);
-            }
+void Activities::writeGraphFile(const string& graphFilePath)
+{
+    path current_path = filesystem::current_path();
+    string file_path = string(current_path.c_str()) + "/inputs/" + graphFilePath;
+    string output_path = path(file_path).replace_extension(".bin").string();
 
-            if (inputEdges)
-            {
-                shared_ptr<Node> startNode = graph->getNodes()[stoi(tokens[0]) - 1];
-                shared_ptr<Node> endNode = graph->getNodes()[stoi(tokens[1]) - 1];
-                float weight = stof(tokens[2]);
-                graph->addEdge(startNode, endNode, weight);
-            }
-        }
+    if (graphKindFromInputFile(graphFilePath) == "directed")
+    {
+        auto graph = buildGraph<DirectedGraph>(graphFilePath);
+        GraphFile::write(*graph, output_path);
+    }
+    else
+    {
+        auto graph = buildGraph<UndirectedGraph>(graphFilePath);
+        GraphFile::write(*graph, output_path);
     }
+
+    cout << "Wrote " << output_path << endl;
 }
 
-void Activities::buildGraphFromInputFile(DirectedGraph* graph, string inputFilePath)
+// The hierarchy of <GraphFile> is kept next to it as <GraphFile>.ch.
+string Activities::contractionHierarchyPath(const string& graphFilePath)
 {
-    char* inputFilePathChar = &inputFilePath[0];
-
-    ifstream inputFile;
-    inputFile.open(inputFilePathChar, ios::in);
-
-    bool inputVertices = false;
-    bool inputArcs = false;
+    path current_path = filesystem::current_path();
+    string file_path = string(current_path.c_str()) + "/inputs/" + graphFilePath;
+    return path(file_path).replace_extension(".ch").string();
+}
 
-    if (inputFile.is_open())
-    {   
-        string line;
-        while (getline(inputFile, line))
-        {
-            stringstream ss(line);
-            string token;
-            vector<string> tokens;
-            while (ss >> token)
-            {
-                tokens.push_back(token);
-            }
+void Activities::writeContractionHierarchy(const string& graphFilePath)
+{
+    checkGraphKindFromInputFile(graphFilePath, "directed");
+    auto graph = buildGraph<DirectedGraph>(graphFilePath);
+
+    auto start = chrono::steady_clock::now();
+    const shared_ptr<ContractionHierarchy>& hierarchy = graph->getContractionHierarchy();
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    string output_path = contractionHierarchyPath(graphFilePath);
+    hierarchy->save(output_path);
+    cout << "Contracted " << hierarchy->getNumberOfVertices() << " vertices with " << hierarchy->getNumberOfShortcuts()
+         << " shortcuts in " << milliseconds << " ms" << endl;
+    cout << "Wrote " << output_path << endl;
+}
 
-            if (tokens[0] == "*vertices")
-            {
-                inputVertices = true;
-                continue;
-            }
+// The landmark tables of <GraphFile> are kept next to it as <GraphFile>.alt.
+string Activities::landmarksPath(const string& graphFilePath)
+{
+    path current_path = filesystem::current_path();
+    string file_path = string(current_path.c_str()) + "/inputs/" + graphFilePath;
+    return path(file_path).replace_extension(".alt").string();
+}
 
-            if (tokens[0] == "*arcs")
-            {
-                inputVertices = false;
-                inputArcs = true;
-                continue;
-            }
+void Activities::writeLandmarks(const string& graphFilePath, int numberOfLandmarks)
+{
+    shared_ptr<const CSRGraph> snapshot;
+    if (graphKindFromInputFile(graphFilePath) == "directed")
+    {
+        snapshot = buildGraph<DirectedGraph>(graphFilePath)->getSnapshot();
+    }
+    else
+    {
+        snapshot = buildGraph<UndirectedGraph>(graphFilePath)->getSnapshot();
+    }
 
-            if (inputVertices)
-            {
-                int index = stoi(tokens[0]);
-                string name;
+    auto start = chrono::steady_clock::now();
+    Landmarks landmarks(snapshot, numberOfLandmarks);
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
 
-                for (long unsigned int i = 1; i < tokens.size() - 1; i++)
-                {
-                    name += tokens[i] + " ";
-                }
-                name += tokens[tokens.size() - 1];
+    string output_path = landmarksPath(graphFilePath);
+    landmarks.save(output_path);
+    cout << "Chose " << landmarks.getNumberOfLandmarks() << " landmarks in " << milliseconds << " ms" << endl;
+    cout << "Wrote " << output_path << endl;
+}
 
-                shared_ptr<Node> nodeSharedPtr = make_shared<Node>(index, name);
-                graph->addNode(nodeSharedPtr);
-            }
+// The distances between all pairs of vertices of <GraphFile> are kept next to it as <GraphFile>.apd.
+string Activities::distanceMatrixPath(const string& graphFilePath)
+{
+    path current_path = filesystem::current_path();
+    string file_path = string(current_path.c_str()) + "/inputs/" + graphFilePath;
+    return path(file_path).replace_extension(".apd").string();
+}
 
-            if (inputArcs)
-            {
-                shared_ptr<Node> startNode = graph->getNodes()[stoi(tokens[0]) - 1];
-                shared_ptr<Node> endNode = graph->getNodes()[stoi(tokens[1]) - 1];
-                float weight = stof(tokens[2]);
+void Activities::writeDistanceMatrix(const string& graphFilePath, DistanceType type)
+{
+    checkGraphKindFromInputFile(graphFilePath, "undirected");
+    auto graph = buildGraph<UndirectedGraph>(graphFilePath);
 
-                graph->addArc(startNode, endNode, weight);
-            }
-        }
+    // Computed straight into the mapped file, with next hops, so the matrix is never held twice.
+    string output_path = distanceMatrixPath(graphFilePath);
+    auto start = chrono::steady_clock::now();
+    {
+        DistanceMatrix D(graph->getNumberOfVertices(), type, true, output_path);
+        graph->allPairsShortestPaths(D);
+        D.setGraphFingerprint(graph->getSnapshot()->getFingerprint());
     }
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Found the distances between " << graph->getNumberOfVertices() << " vertices in " << milliseconds << " ms" << endl;
+    cout << "Wrote " << output_path << endl;
 }
 
-void Activities::checkGraphKindFromInputFile(const string& graphFilePath, const string& expectedKind)
+string Activities::graphKindFromInputFile(const string& graphFilePath)
 {
     path current_path = filesystem::current_path();
     string file_path = string(current_path.c_str()) + "/inputs/" + graphFilePath;
 
-    ifstream inputFile;
-    inputFile.open(file_path, ios::in);
-
-    string foundKind;
-
-    if (inputFile.is_open())
+    if (GraphFile::isGraphFile(file_path))
     {
-        string line;
-        while (getline(inputFile, line))
-        {
-            stringstream ss(line);
-            string token;
-            vector<string> tokens;
-            while (ss >> token)
-            {
-                tokens.push_back(token);
-            }
-
-            if (tokens[0] == "*edges")
-            {
-                foundKind = "undirected";
-            }
-
-            if (tokens[0] == "*arcs")
-            {
-                foundKind = "directed";
-            }
-        }
+        return GraphFile(file_path).isDirected() ? "directed" : "undirected";
     }
+    return PajekLoader::detectKind(file_path);
+}
+
+void Activities::checkGraphKindFromInputFile(const string& graphFilePath, const string& expectedKind)
+{
+    string foundKind = graphKindFromInputFile(graphFilePath);
 
     if (foundKind != expectedKind)
     {
         throw invalid_argument("Graph needs to be " + expectedKind);
     }
 
-}
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cctype>
 #include <dirent.h>
 #include <map>
 
@@ -11,6 +12,7 @@
 #include "Graph/DirectedGraph.h"
 #include "Graph/Node.h"
 #include "Activities/Activities.h"
+#include "Activities/QueryServer.h"
 
 using namespace std;
 using namespace filesystem;
@@ -18,9 +20,67 @@ using namespace GraphActivity;
 using namespace GraphModule;
 
 // ./Main <Activity> <Question> <<GraphFile> or <-d>> d = default
+// ./Main convert <Activity>/<GraphFile> writes the binary <GraphFile>.bin next to it, usable as a GraphFile afterwards
+// ./Main contract <Activity>/<GraphFile> writes the contraction hierarchy <GraphFile>.ch of a directed graph, loaded by serve
+// ./Main landmarks <Activity>/<GraphFile> [<Count>] writes the ALT landmark tables <GraphFile>.alt, 16 landmarks by default, loaded by serve
+// ./Main distances <Activity>/<GraphFile> [int32|float32|uint16] writes the distances and next hops of all pairs <GraphFile>.apd, used by A1 5
+// ./Main serve <Activity>/<GraphFile> [<SocketPath>] keeps the graph loaded and answers queries, see QueryServer
 
 void MainClass::Main(int argc, char *argv[])
 {
+    if (argc == 3 && string(argv[1]) == "convert")
+    {
+        Activities::writeGraphFile(argv[2]);
+        return;
+    }
+
+    if (argc == 3 && string(argv[1]) == "contract")
+    {
+        Activities::writeContractionHierarchy(argv[2]);
+        return;
+    }
+
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "landmarks")
+    {
+        string count = argc == 4 ? argv[3] : "16";
+        bool countIsNumber = !count.empty() && count.size() <= 9
+                             && all_of(count.begin(), count.end(), [](char c) { return isdigit(static_cast<unsigned char>(c)); });
+        if (!countIsNumber || stoi(count) < 1)
+        {
+            cout << "Error: Invalid number of landmarks " << count << ", expected a positive integer" << endl;
+            return;
+        }
+        Activities::writeLandmarks(argv[2], stoi(count));
+        return;
+    }
+
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "distances")
+    {
+        map<string, DistanceType> types = {{"int32", DistanceType::INT32}, {"float32", DistanceType::FLOAT32}, {"uint16", DistanceType::UINT16}};
+        string type = argc == 4 ? argv[3] : "int32";
+        if (types.count(type) == 0)
+        {
+            cout << "Error: Invalid distance type " << type << ", expected int32, float32 or uint16" << endl;
+            return;
+        }
+        Activities::writeDistanceMatrix(argv[2], types[type]);
+        return;
+    }
+
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "serve")
+    {
+        QueryServer server(argv[2]);
+        if (argc == 4)
+        {
+            server.serveSocket(argv[3]);
+        }
+        else
+        {
+            server.serve(cin, cout);
+        }
+        return;
+    }
+
     bool argsAreOk = checkArguments(argc, argv);
 
     if (argsAreOk)
@@ -52,7 +112,12 @@ bool MainClass::checkArguments(int argc, char *argv[])
                               "Activity: A1, A2 or A3 \n"
                               "Question: number of the question as in pdf activity file \n"
                               "graphFile: name of the file \n"
-                              "-d: A flag that indicates if the default graph will be used";
+                              "-d: A flag that indicates if the default graph will be used \n"
+                              "Or: ./Main convert <Activity>/<GraphFile> to write a binary copy of the graph \n"
+                              "Or: ./Main contract <Activity>/<GraphFile> to write the contraction hierarchy of a directed graph \n"
+                              "Or: ./Main landmarks <Activity>/<GraphFile> [<Count>] to write the landmark tables used by ALT \n"
+                              "Or: ./Main distances <Activity>/<GraphFile> [int32|float32|uint16] to write the distances between all pairs \n"
+                              "Or: ./Main serve <Activity>/<GraphFile> [<SocketPath>] to answer queries from stdin or a Unix socket";
         cout << errorMessage << endl;
 
         return false;
@@ -89,7 +154,12 @@ bool MainClass::checkArguments(int argc, char *argv[])
                               "Activity: A1, A2 or A3 \n"
                               "Question: number of the question as in pdf activity file \n"
                               "graphFile: name of the file \n"
-                              "-d: A flag that indicates if the default graph will be used";
+                              "-d: A flag that indicates if the default graph will be used \n"
+                              "Or: ./Main convert <Activity>/<GraphFile> to write a binary copy of the graph \n"
+                              "Or: ./Main contract <Activity>/<GraphFile> to write the contraction hierarchy of a directed graph \n"
+                              "Or: ./Main landmarks <Activity>/<GraphFile> [<Count>] to write the landmark tables used by ALT \n"
+                              "Or: ./Main distances <Activity>/<GraphFile> [int32|float32|uint16] to write the distances between all pairs \n"
+                              "Or: ./Main serve <Activity>/<GraphFile> [<SocketPath>] to answer queries from stdin or a Unix socket";
             cout << errorMessage << endl;
 
             return false;
@@ -0,0 +1,523 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
+#include <exception>
+
+#include "Activities/PajekLoader.h"
+#include "Graph/UndirectedGraph.h"
+#include "Graph/DirectedGraph.h"
+#include "Graph/Node.h"
+#include "Graph/MappedFile.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/ArcAttributes.h"
+
+using namespace std;
+using namespace GraphActivity;
+using namespace GraphModule;
+
+namespace
+{
+    bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    // Returns the next whitespace separated token and moves the cursor past it. Empty when the line is over.
+    string_view nextToken(const char*& cursor, const char* end)
+    {
+        while (cursor < end && isBlank(*cursor))
+        {
+            cursor++;
+        }
+        const char* tokenBegin = cursor;
+        while (cursor < end && !isBlank(*cursor))
+        {
+            cursor++;
+        }
+        return string_view(tokenBegin, cursor - tokenBegin);
+    }
+
+    bool parseInt(string_view token, int& value)
+    {
+        auto result = from_chars(token.data(), token.data() + token.size(), value);
+        return result.ec == errc() && result.ptr == token.data() + token.size();
+    }
+
+    bool parseFloat(string_view token, float& value)
+    {
+        auto result = from_chars(token.data(), token.data() + token.size(), value);
+        return result.ec == errc() && result.ptr == token.data() + token.size();
+    }
+
+    bool equalsIgnoringCase(string_view token, const char* keyword)
+    {
+        size_t length = strlen(keyword);
+        if (token.size() != length)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < length; i++)
+        {
+            if (tolower(static_cast<unsigned char>(token[i])) != keyword[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Calls lineHandler(begin, end) for every line of the buffer that is neither blank nor a % comment.
+    template <typename LineHandler>
+    void forEachLine(const char* data, size_t size, LineHandler lineHandler)
+    {
+        const char* cursor = data;
+        const char* end = data + size;
+        while (cursor < end)
+        {
+            const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+
+            const char* lineBegin = cursor;
+            while (lineBegin < lineEnd && isBlank(*lineBegin))
+            {
+                lineBegin++;
+            }
+            if (lineBegin < lineEnd && *lineBegin != '%')
+            {
+                lineHandler(lineBegin, lineEnd);
+            }
+
+            cursor = lineEnd + 1;
+        }
+    }
+}
+
+PajekLoader::PajekLoader(const string& inputFilePath)
+{
+    this->file = make_shared<MappedFile>(inputFilePath);
+    this->numberOfEdgeLines = 0;
+    this->numberOfDeclaredVertices = 0;
+    this->everyVertexHasCoordinates = true;
+
+    // Jumps from header to header. The lines in between belong to the section of the last header.
+    const char* cursor = this->file->data();
+    const char* end = cursor + this->file->size();
+    Section section = NONE;
+    while (cursor < end)
+    {
+        const char* header = findNextHeader(cursor, end);
+        if (section == VERTICES)
+        {
+            forEachLine(cursor, header - cursor, [&](const char* lineBegin, const char* lineEnd)
+            {
+                this->parseVertex(lineBegin, lineEnd);
+            });
+        }
+        else if (section == EDGES || section == ARCS)
+        {
+            this->parseConnections(cursor, header, section == EDGES);
+        }
+
+        if (header == end)
+        {
+            break;
+        }
+        const char* headerEnd = static_cast<const char*>(memchr(header, '\n', end - header));
+        if (headerEnd == nullptr)
+        {
+            headerEnd = end;
+        }
+
+        section = parseSectionHeader(header, headerEnd);
+        if (section == VERTICES)
+        {
+            const char* headerCursor = header;
+            nextToken(headerCursor, headerEnd);
+            int count;
+            if (parseInt(nextToken(headerCursor, headerEnd), count) && count > 0)
+            { // The count is only a hint, some inputs declare fewer vertices than they list
+                this->numbers.reserve(count);
+                this->names.reserve(count);
+                this->numberOfDeclaredVertices = count;
+            }
+        }
+        cursor = headerEnd == end ? end : headerEnd + 1;
+    }
+
+    // A header without vertex lines stands for vertices 1 to its count, named by their numbers.
+    if (this->numbers.empty() && this->numberOfDeclaredVertices > 0)
+    {
+        for (uint32_t number = 1; number <= this->numberOfDeclaredVertices; number++)
+        {
+            this->numbers.push_back(number);
+            this->names.push_back(to_string(number));
+        }
+        this->everyVertexHasCoordinates = false;
+    }
+}
+
+const char* PajekLoader::findNextHeader(const char* begin, const char* end)
+{
+    // A header is a '*' with nothing but blanks before it on its line. begin is always the start of a line.
+    const char* cursor = begin;
+    while (cursor < end)
+    {
+        const char* star = static_cast<const char*>(memchr(cursor, '*', end - cursor));
+        if (star == nullptr)
+        {
+            return end;
+        }
+        const char* lineStart = star;
+        while (lineStart > begin && isBlank(lineStart[-1]))
+        {
+            lineStart--;
+        }
+        if (lineStart == begin || lineStart[-1] == '\n')
+        {
+            return star;
+        }
+        cursor = star + 1;
+    }
+    return end;
+}
+
+void PajekLoader::parseConnections(const char* begin, const char* end, bool bothWays)
+{
+    // Every worker gets a byte range cut at line boundaries and parses it into its own buffer.
+    // Small sections are parsed on the calling thread, where a thread would cost more than the parse.
+    size_t size = end - begin;
+    size_t numberOfWorkers = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), size / MINIMUM_CHUNK_SIZE));
+
+    vector<const char*> boundaries(numberOfWorkers + 1, end);
+    boundaries[0] = begin;
+    for (size_t t = 1; t < numberOfWorkers; t++)
+    {
+        const char* cut = max(begin + size * t / numberOfWorkers, boundaries[t - 1]);
+        const char* lineEnd = static_cast<const char*>(memchr(cut, '\n', end - cut));
+        boundaries[t] = lineEnd == nullptr ? end : lineEnd + 1;
+    }
+
+    vector<ConnectionBuffer> buffers(numberOfWorkers);
+    vector<exception_ptr> errors(numberOfWorkers);
+    auto parseChunk = [&](size_t t)
+    {
+        try
+        {
+            forEachLine(boundaries[t], boundaries[t + 1] - boundaries[t], [&](const char* lineBegin, const char* lineEnd)
+            {
+                this->parseConnection(lineBegin, lineEnd, buffers[t]);
+            });
+        }
+        catch (...)
+        {
+            errors[t] = current_exception();
+        }
+    };
+
+    vector<thread> workers;
+    for (size_t t = 1; t < numberOfWorkers; t++)
+    {
+        workers.emplace_back(parseChunk, t);
+    }
+    parseChunk(0);
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+    for (const exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            rethrow_exception(error);
+        }
+    }
+
+    // Buffers are appended in range order, so the connections keep the order of the file.
+    size_t numberOfLines = 0;
+    for (const ConnectionBuffer& buffer : buffers)
+    {
+        numberOfLines += buffer.sources.size();
+    }
+    this->connections.sources.reserve(this->connections.sources.size() + numberOfLines);
+    this->connections.targets.reserve(this->connections.targets.size() + numberOfLines);
+    this->connections.weights.reserve(this->connections.weights.size() + numberOfLines);
+    this->connections.tails.reserve(this->connections.tails.size() + numberOfLines);
+    for (const ConnectionBuffer& buffer : buffers)
+    {
+        this->connections.sources.insert(this->connections.sources.end(), buffer.sources.begin(), buffer.sources.end());
+        this->connections.targets.insert(this->connections.targets.end(), buffer.targets.begin(), buffer.targets.end());
+        this->connections.weights.insert(this->connections.weights.end(), buffer.weights.begin(), buffer.weights.end());
+        this->connections.tails.insert(this->connections.tails.end(), buffer.tails.begin(), buffer.tails.end());
+        this->connections.hasTails = this->connections.hasTails || buffer.hasTails;
+    }
+    this->bothWays.insert(this->bothWays.end(), numberOfLines, bothWays);
+    if (bothWays)
+    {
+        this->numberOfEdgeLines += numberOfLines;
+    }
+}
+
+PajekLoader::Section PajekLoader::parseSectionHeader(const char* begin, const char* end)
+{
+    const char* cursor = begin + 1;
+    string_view keyword = nextToken(cursor, end);
+
+    if (equalsIgnoringCase(keyword, "vertices"))
+    {
+        return VERTICES;
+    }
+    if (equalsIgnoringCase(keyword, "edges"))
+    {
+        return EDGES;
+    }
+    if (equalsIgnoringCase(keyword, "arcs"))
+    {
+        return ARCS;
+    }
+    return NONE;
+}
+
+void PajekLoader::parseVertex(const char* begin, const char* end)
+{
+    const char* cursor = begin;
+    string_view numberToken = nextToken(cursor, end);
+    int number;
+    if (!parseInt(numberToken, number))
+    {
+        throw invalid_argument("Invalid vertex '" + string(numberToken) + "' in " + this->file->getPath());
+    }
+
+    // The name is the rest of the line with its tokens joined by single spaces, or the number when there is none.
+    // Pajek puts the layout right after the label, so the two tokens following it are read as coordinates when they are numbers.
+    string name;
+    int tokenIndex = 0;
+    int coordinatesIndex = 1;
+    bool insideQuotes = false;
+    float coordinate[2];
+    int coordinatesFound = 0;
+    for (string_view token = nextToken(cursor, end); !token.empty(); token = nextToken(cursor, end))
+    {
+        if (!name.empty())
+        {
+            name += ' ';
+        }
+        name.append(token.data(), token.size());
+
+        if (tokenIndex == 0 && token.front() == '"')
+        {
+            insideQuotes = token.size() == 1 || token.back() != '"';
+        }
+        else if (insideQuotes)
+        {
+            insideQuotes = token.back() != '"';
+            coordinatesIndex = tokenIndex + 1;
+        }
+        else if (tokenIndex >= coordinatesIndex && tokenIndex < coordinatesIndex + 2 && parseFloat(token, coordinate[tokenIndex - coordinatesIndex]))
+        {
+            coordinatesFound++;
+        }
+        tokenIndex++;
+    }
+    if (name.empty())
+    {
+        name = string(numberToken);
+    }
+
+    if (coordinatesFound == 2)
+    {
+        this->coordinates.push_back(coordinate[0]);
+        this->coordinates.push_back(coordinate[1]);
+    }
+    else
+    {
+        this->everyVertexHasCoordinates = false;
+    }
+
+    this->numbers.push_back(number);
+    this->names.push_back(std::move(name));
+}
+
+void PajekLoader::parseConnection(const char* begin, const char* end, ConnectionBuffer& buffer) const
+{
+    const char* cursor = begin;
+    string_view sourceToken = nextToken(cursor, end);
+    string_view targetToken = nextToken(cursor, end);
+    string_view weightToken = nextToken(cursor, end);
+
+    int source, target;
+    if (!parseInt(sourceToken, source) || !parseInt(targetToken, target))
+    {
+        throw invalid_argument("Invalid connection '" + string(begin, end) + "' in " + this->file->getPath());
+    }
+
+    float weight = 1; // Pajek default for unweighted connections
+    if (!weightToken.empty() && !parseFloat(weightToken, weight))
+    {
+        throw invalid_argument("Invalid weight '" + string(weightToken) + "' in " + this->file->getPath());
+    }
+
+    // Whatever follows the weight is kept as a position in the file, ArcAttributes parses it when asked.
+    while (cursor < end && isBlank(*cursor))
+    {
+        cursor++;
+    }
+    const char* tailEnd = end;
+    while (tailEnd > cursor && isBlank(tailEnd[-1]))
+    {
+        tailEnd--;
+    }
+
+    buffer.sources.push_back(source);
+    buffer.targets.push_back(target);
+    buffer.weights.push_back(weight);
+    buffer.tails.push_back({static_cast<uint64_t>(cursor - this->file->data()), static_cast<uint32_t>(tailEnd - cursor)});
+    buffer.hasTails = buffer.hasTails || cursor < tailEnd;
+}
+
+void PajekLoader::build(UndirectedGraph* graph)
+{
+    const ConnectionBuffer& edges = this->connections;
+    this->addNodes(graph, 2 * edges.sources.size());
+    uint32_t firstConnection = graph->getStorage().getNumberOfConnections();
+
+    // Edges go through addEdge, which also records how each edge was written for the bipartition.
+    const vector<shared_ptr<Node>>& nodes = graph->getNodes();
+    for (size_t i = 0; i < edges.sources.size(); i++)
+    {
+        graph->addEdge(nodes[this->nodeIndex(edges.sources[i])], nodes[this->nodeIndex(edges.targets[i])], edges.weights[i]);
+    }
+
+    if (edges.hasTails)
+    { // addEdge adds one connection per direction, both share the attributes of their line
+        vector<ArcAttributes::Tail> tails(firstConnection, {0, 0});
+        tails.reserve(firstConnection + 2 * edges.tails.size());
+        for (const ArcAttributes::Tail& tail : edges.tails)
+        {
+            tails.push_back(tail);
+            tails.push_back(tail);
+        }
+        graph->getStorage().setArcAttributes(make_shared<ArcAttributes>(this->file, std::move(tails)));
+    }
+}
+
+void PajekLoader::build(DirectedGraph* graph)
+{
+    const ConnectionBuffer& arcs = this->connections;
+    uint32_t numberOfVertices = this->numbers.size();
+    uint32_t numberOfArcs = arcs.sources.size() + this->numberOfEdgeLines;
+    this->addNodes(graph, numberOfArcs);
+    uint32_t firstConnection = graph->getStorage().getNumberOfConnections();
+
+    // Stable counting sort of the arcs by source. An edge of a directed graph is a pair of opposite arcs.
+    vector<uint32_t> offsets(numberOfVertices + 1, 0);
+    for (size_t i = 0; i < arcs.sources.size(); i++)
+    {
+        offsets[this->nodeIndex(arcs.sources[i]) + 1]++;
+        uint32_t target = this->nodeIndex(arcs.targets[i]);
+        if (this->bothWays[i])
+        {
+            offsets[target + 1]++;
+        }
+    }
+    for (uint32_t v = 0; v < numberOfVertices; v++)
+    {
+        offsets[v + 1] += offsets[v];
+    }
+
+    vector<uint32_t> position(offsets.begin(), offsets.end() - 1);
+    vector<uint32_t> targets(numberOfArcs);
+    vector<float> weights(numberOfArcs);
+    vector<ArcAttributes::Tail> tails(arcs.hasTails ? firstConnection + numberOfArcs : 0, {0, 0});
+    for (size_t i = 0; i < arcs.sources.size(); i++)
+    {
+        uint32_t source = arcs.sources[i] - 1;
+        uint32_t target = arcs.targets[i] - 1;
+        uint32_t slot = position[source]++;
+        targets[slot] = target;
+        weights[slot] = arcs.weights[i];
+        if (arcs.hasTails)
+        {
+            tails[firstConnection + slot] = arcs.tails[i];
+        }
+        if (this->bothWays[i])
+        {
+            slot = position[target]++;
+            targets[slot] = source;
+            weights[slot] = arcs.weights[i];
+            if (arcs.hasTails)
+            {
+                tails[firstConnection + slot] = arcs.tails[i];
+            }
+        }
+    }
+
+    // addConnections adds the slots in order, so slot i becomes connection firstConnection + i.
+    graph->addConnections(offsets.data(), targets.data(), weights.data());
+    if (arcs.hasTails)
+    {
+        graph->getStorage().setArcAttributes(make_shared<ArcAttributes>(this->file, std::move(tails)));
+    }
+}
+
+void PajekLoader::addNodes(AbstractGraph* graph, uint32_t numberOfConnections)
+{
+    graph->reserve(this->numbers.size(), numberOfConnections);
+    for (size_t i = 0; i < this->numbers.size(); i++)
+    {
+        graph->addNode(make_shared<Node>(this->numbers[i], std::move(this->names[i])));
+    }
+
+    if (this->everyVertexHasCoordinates && !this->numbers.empty())
+    {
+        for (size_t i = 0; i < this->numbers.size(); i++)
+        {
+            graph->getStorage().setCoordinates(i, this->coordinates[2 * i], this->coordinates[2 * i + 1]);
+        }
+    }
+}
+
+uint32_t PajekLoader::nodeIndex(int number)
+{
+    if (number < 1 || number > static_cast<int>(this->numbers.size()))
+    {
+        throw invalid_argument("Connection to unknown vertex " + to_string(number) + " in " + this->file->getPath());
+    }
+    return number - 1;
+}
+
+string PajekLoader::detectKind(const string& inputFilePath)
+{
+    MappedFile file(inputFilePath);
+    string foundKind;
+
+    forEachLine(file.data(), file.size(), [&](const char* begin, const char* end)
+    {
+        if (*begin == '*')
+        {
+            Section section = parseSectionHeader(begin, end);
+            if (section == EDGES)
+            {
+                foundKind = "undirected";
+            }
+            else if (section == ARCS)
+            {
+                foundKind = "directed";
+            }
+        }
+    });
+
+    return foundKind;
+}
+
+PajekLoader::~PajekLoader()
+= default;
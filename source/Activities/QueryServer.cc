@@ -0,0 +1,552 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Activities/QueryServer.h"
+#include "Activities/Activities.h"
+#include "Graph/UndirectedGraph.h"
+#include "Graph/DirectedGraph.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/ShortestPathTrees.h"
+#include "Graph/PredecessorPaths.h"
+#include "Graph/BreadthFirstSearch.h"
+#include "Graph/MultiSourceBFS.h"
+#include "Graph/StronglyConnectedComponents.h"
+#include "Graph/Landmarks.h"
+#include "Graph/ContractionHierarchy.h"
+
+using namespace std;
+using namespace GraphActivity;
+using namespace GraphModule;
+
+namespace
+{
+    const int INFINITE_DISTANCE = 1000000; // Distance the graph algorithms give to unreachable vertices
+    const int ACCEPT_RETRY_MILLISECONDS = 100; // Wait before accepting again when out of descriptors or memory
+
+    string escape(const string& text)
+    {
+        string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c == '\n' || c == '\r' || c == '\t' ? ' ' : c;
+        }
+        return escaped;
+    }
+
+    // Unreachable vertices are written as null.
+    string distancesToJson(const int* distances, int numberOfVertices)
+    {
+        string json = "[";
+        for (int v = 0; v < numberOfVertices; v++)
+        {
+            if (v > 0)
+            {
+                json += ',';
+            }
+            json += distances[v] >= INFINITE_DISTANCE ? "null" : to_string(distances[v]);
+        }
+        return json + "]";
+    }
+
+    string distancesToJson(const vector<int>& distances)
+    {
+        return distancesToJson(distances.data(), distances.size());
+    }
+
+    // Vertex indexes are written as the 1-based numbers of the input.
+    string pathToJson(const vector<int>& path)
+    {
+        string json = "[";
+        for (size_t i = 0; i < path.size(); i++)
+        {
+            json += (i == 0 ? "" : ",") + to_string(path[i] + 1);
+        }
+        return json + "]";
+    }
+
+    // Whether every parent chain of A is a path of the snapshot from the source whose arcs add up to the distance in D.
+    bool isShortestPathTree(const CSRGraph& snapshot, int source, const vector<int>& D, const vector<int>& A)
+    {
+        ArrayView<uint32_t> reverseOffsets = snapshot.getReverseOffsets();
+        ArrayView<uint32_t> sources = snapshot.getSources();
+        ArrayView<float> reverseWeights = snapshot.getReverseWeights();
+        int numberOfVertices = snapshot.getNumberOfVertices();
+        if (D[source] != 0 || A[source] != -1)
+        {
+            return false;
+        }
+        for (int v = 0; v < numberOfVertices; v++)
+        {
+            if (v == source || D[v] >= INFINITE_DISTANCE)
+            {
+                continue;
+            }
+            int u = A[v];
+            if (u < 0 || u >= numberOfVertices || D[u] >= INFINITE_DISTANCE)
+            {
+                return false;
+            }
+            bool arcFound = false;
+            for (uint32_t arc = reverseOffsets[v]; arc < reverseOffsets[v + 1] && !arcFound; arc++)
+            {
+                arcFound = static_cast<int>(sources[arc]) == u && D[u] + static_cast<int>(reverseWeights[arc]) == D[v];
+            }
+            if (!arcFound)
+            {
+                return false;
+            }
+        }
+
+        // Tight arcs can still close a cycle over zero weights, so every chain has to end at the source.
+        vector<char> state(numberOfVertices, 0); // 1 while on the chain being walked, 2 once known to reach the source
+        state[source] = 2;
+        vector<int> chain;
+        for (int v = 0; v < numberOfVertices; v++)
+        {
+            int u = v;
+            while (D[u] < INFINITE_DISTANCE && state[u] == 0)
+            {
+                state[u] = 1;
+                chain.push_back(u);
+                u = A[u];
+            }
+            if (D[u] < INFINITE_DISTANCE && state[u] == 1)
+            {
+                return false;
+            }
+            for (int w : chain)
+            {
+                state[w] = 2;
+            }
+            chain.clear();
+        }
+        return true;
+    }
+
+    bool writeAll(int socketDescriptor, const string& text)
+    {
+        size_t written = 0;
+        while (written < text.size())
+        {
+            ssize_t result = send(socketDescriptor, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+            if (result <= 0)
+            {
+                return false;
+            }
+            written += result;
+        }
+        return true;
+    }
+}
+
+QueryServer::QueryServer(const string& graphFilePath)
+{
+    this->graphFilePath = graphFilePath;
+    this->numberOfQueries = 0;
+    this->contractionHierarchyReady = false;
+    this->landmarksReady = false;
+
+    auto start = chrono::steady_clock::now();
+    if (Activities::graphKindFromInputFile(graphFilePath) == "directed")
+    {
+        this->directedGraph = Activities::buildGraph<DirectedGraph>(graphFilePath);
+        this->graph = this->directedGraph.get();
+    }
+    else
+    {
+        this->undirectedGraph = Activities::buildGraph<UndirectedGraph>(graphFilePath);
+        this->graph = this->undirectedGraph.get();
+    }
+    this->graph->getSnapshot(); // Built once here instead of inside the first query
+    this->loadMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void QueryServer::serve(istream& input, ostream& output)
+{
+    output << "{\"status\":\"ready\",\"graph\":\"" << escape(this->graphFilePath) << "\",\"load_ms\":" << this->loadMilliseconds << "}" << endl;
+
+    string request;
+    bool quit = false;
+    while (!quit && getline(input, request))
+    {
+        string response = this->answer(request, quit);
+        if (!response.empty())
+        {
+            output << response << endl;
+        }
+    }
+}
+
+void QueryServer::serveSocket(const string& socketPath)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw invalid_argument("Socket path is too long: " + socketPath);
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        throw runtime_error("Could not create a socket");
+    }
+    unlink(socketPath.c_str()); // Left behind by a previous server
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, 16) < 0)
+    {
+        close(listener);
+        throw runtime_error("Could not listen on " + socketPath);
+    }
+
+    cout << "{\"status\":\"ready\",\"graph\":\"" << escape(this->graphFilePath) << "\",\"socket\":\"" << escape(socketPath)
+         << "\",\"load_ms\":" << this->loadMilliseconds << "}" << endl;
+
+    // Clients are served one after the other. A quit ends the session of its client, not the server.
+    while (true)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            int error = errno;
+            if (error == EINTR || error == ECONNABORTED)
+            {
+                continue; // Only this attempt failed
+            }
+            cerr << "Could not accept a client: " << strerror(error) << endl;
+            if (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM)
+            {
+                this_thread::sleep_for(chrono::milliseconds(ACCEPT_RETRY_MILLISECONDS)); // Resources may come back
+                continue;
+            }
+            close(listener);
+            throw runtime_error("Could not accept clients on " + socketPath);
+        }
+
+        string pending;
+        char buffer[4096];
+        bool quit = false;
+        ssize_t received;
+        while (!quit && (received = read(client, buffer, sizeof(buffer))) > 0)
+        {
+            pending.append(buffer, received);
+            size_t lineEnd;
+            while (!quit && (lineEnd = pending.find('\n')) != string::npos)
+            {
+                string response = this->answer(pending.substr(0, lineEnd), quit);
+                pending.erase(0, lineEnd + 1);
+                if (!response.empty() && !writeAll(client, response + "\n"))
+                {
+                    quit = true;
+                }
+            }
+        }
+        close(client);
+    }
+}
+
+string QueryServer::answer(const string& request, bool& quit)
+{
+    istringstream tokens(request);
+    string query;
+    if (!(tokens >> query))
+    {
+        return ""; // Blank lines are ignored
+    }
+    if (query == "quit")
+    {
+        quit = true;
+        return "";
+    }
+
+    this->numberOfQueries++;
+    string prefix = "{\"id\":" + to_string(this->numberOfQueries) + ",\"query\":\"" + escape(query) + "\"";
+    auto start = chrono::steady_clock::now();
+    string status, payload;
+    try
+    {
+        vector<int> arguments;
+        string token;
+        while (tokens >> token)
+        {
+            int argument;
+            auto result = from_chars(token.data(), token.data() + token.size(), argument);
+            if (result.ec != errc() || result.ptr != token.data() + token.size())
+            {
+                throw invalid_argument("Invalid argument " + token);
+            }
+            arguments.push_back(argument);
+        }
+        payload = this->run(query, arguments);
+        status = "ok";
+    }
+    catch (const exception& error)
+    {
+        status = "error";
+        payload = ",\"message\":\"" + escape(error.what()) + "\"";
+    }
+    double latency = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    return prefix + ",\"status\":\"" + status + "\",\"latency_us\":" + to_string(latency) + payload + "}";
+}
+
+string QueryServer::run(const string& query, const vector<int>& arguments)
+{
+    auto expectArguments = [&](size_t minimum, size_t maximum)
+    {
+        if (arguments.size() < minimum || arguments.size() > maximum)
+        {
+            throw invalid_argument("Wrong number of arguments for " + query);
+        }
+    };
+    auto needs = [&](bool available, const string& kind)
+    {
+        if (!available)
+        {
+            throw invalid_argument(query + " only runs on " + kind + " graphs");
+        }
+    };
+
+    if (query == "info")
+    {
+        expectArguments(0, 0);
+        shared_ptr<const CSRGraph> snapshot = this->graph->getSnapshot();
+        return ",\"vertices\":" + to_string(snapshot->getNumberOfVertices()) + ",\"arcs\":" + to_string(snapshot->getNumberOfArcs())
+               + ",\"directed\":" + (snapshot->isDirected() ? "true" : "false");
+    }
+
+    if (query == "degree")
+    {
+        expectArguments(1, 1);
+        return ",\"degree\":" + to_string(this->graph->getDegreeOfNode(this->vertexIndex(arguments[0])));
+    }
+
+    if (query == "bfs")
+    {
+        expectArguments(1, 1);
+        BreadthFirstSearch search = this->graph->breadthFirstLevels(this->vertexIndex(arguments[0]));
+        return ",\"distances\":" + distancesToJson(search.getDistances()) + ",\"levels\":" + to_string(search.getNumberOfLevels())
+               + ",\"bottom_up_steps\":" + to_string(search.getNumberOfBottomUpSteps());
+    }
+
+    if (query == "eccentricity")
+    {
+        vector<int> sources;
+        for (int argument : arguments)
+        {
+            sources.push_back(this->vertexIndex(argument));
+        }
+        if (sources.empty())
+        {
+            for (int v = 0; v < this->graph->getNumberOfVertices(); v++)
+            {
+                sources.push_back(v);
+            }
+        }
+        if (!this->multiSourceBFS)
+        {
+            this->multiSourceBFS = make_unique<MultiSourceBFS>(this->graph->getSnapshot());
+        }
+        string eccentricities, reached, closeness;
+        for (const MultiSourceBFS::Statistics& statistics : this->multiSourceBFS->statistics(sources))
+        {
+            string separator = eccentricities.empty() ? "" : ",";
+            eccentricities += separator + to_string(statistics.eccentricity);
+            reached += separator + to_string(statistics.numberOfReached);
+            closeness += separator + to_string(statistics.closeness);
+        }
+        return ",\"eccentricity\":[" + eccentricities + "],\"reached\":[" + reached + "],\"closeness\":[" + closeness + "]";
+    }
+
+    if (query == "dijkstra" || query == "radix-dijkstra" || query == "delta-stepping")
+    {
+        expectArguments(1, 2);
+        int source = this->vertexIndex(arguments[0]);
+        DijkstraQueue queue = query == "dijkstra" ? DijkstraQueue::INDEXED_HEAP
+                              : query == "radix-dijkstra" ? DijkstraQueue::RADIX_HEAP : DijkstraQueue::DELTA_STEPPING;
+        auto [D, A] = this->graph->dijkstra(source, queue);
+        if (arguments.size() == 1)
+        {
+            return ",\"distances\":" + distancesToJson(D);
+        }
+
+        int target = this->vertexIndex(arguments[1]);
+        if (D[target] >= INFINITE_DISTANCE)
+        {
+            return ",\"distance\":null,\"path\":[]";
+        }
+        return ",\"distance\":" + to_string(D[target]) + ",\"path\":" + pathToJson(PredecessorPaths(A, source).path(target));
+    }
+
+    if (query == "trees")
+    {
+        if (arguments.empty())
+        {
+            throw invalid_argument("Wrong number of arguments for " + query);
+        }
+        vector<int> sources;
+        for (int argument : arguments)
+        {
+            sources.push_back(this->vertexIndex(argument));
+        }
+        ShortestPathTrees trees = this->graph->shortestPathTrees(sources);
+        string rows;
+        for (int tree = 0; tree < trees.getNumberOfTrees(); tree++)
+        {
+            rows += (tree == 0 ? "" : ",") + distancesToJson(trees.distanceRow(tree), trees.getNumberOfVertices());
+        }
+        return ",\"distances\":[" + rows + "]";
+    }
+
+    if (query == "path")
+    {
+        expectArguments(2, 2);
+        int source = this->vertexIndex(arguments[0]);
+        int target = this->vertexIndex(arguments[1]);
+        auto [distance, path] = this->graph->shortestPath(source, target);
+        return ",\"distance\":" + (path.empty() ? string("null") : to_string(distance)) + ",\"path\":" + pathToJson(path)
+               + ",\"settled\":" + to_string(this->graph->getNumberOfSettledVertices());
+    }
+
+    if (query == "astar")
+    {
+        expectArguments(2, 2);
+        int source = this->vertexIndex(arguments[0]);
+        int target = this->vertexIndex(arguments[1]);
+        auto [distance, path] = this->graph->aStar(source, target);
+        return ",\"distance\":" + (path.empty() ? string("null") : to_string(distance)) + ",\"path\":" + pathToJson(path)
+               + ",\"settled\":" + to_string(this->graph->getNumberOfSettledVertices());
+    }
+
+    if (query == "alt")
+    {
+        expectArguments(2, 2);
+        int source = this->vertexIndex(arguments[0]);
+        int target = this->vertexIndex(arguments[1]);
+        if (!this->landmarksReady)
+        {
+            // Saved landmarks spare choosing them, otherwise the graph chooses them on this first query.
+            string landmarksPath = Activities::landmarksPath(this->graphFilePath);
+            if (filesystem::exists(landmarksPath))
+            {
+                this->graph->setLandmarks(make_shared<Landmarks>(this->graph->getSnapshot(), landmarksPath));
+            }
+            this->landmarksReady = true;
+        }
+        auto [distance, path] = this->graph->landmarkAStar(source, target);
+        return ",\"distance\":" + (path.empty() ? string("null") : to_string(distance)) + ",\"path\":" + pathToJson(path)
+               + ",\"settled\":" + to_string(this->graph->getNumberOfSettledVertices());
+    }
+
+    if (query == "ch")
+    {
+        expectArguments(2, 2);
+        needs(this->directedGraph != nullptr, "directed");
+        int source = this->vertexIndex(arguments[0]);
+        int target = this->vertexIndex(arguments[1]);
+        if (!this->contractionHierarchyReady)
+        {
+            // A saved hierarchy spares the preprocessing, otherwise the graph is contracted on this first query.
+            string hierarchyPath = Activities::contractionHierarchyPath(this->graphFilePath);
+            if (filesystem::exists(hierarchyPath))
+            {
+                this->directedGraph->setContractionHierarchy(make_shared<ContractionHierarchy>(hierarchyPath));
+            }
+            this->contractionHierarchyReady = true;
+        }
+        const shared_ptr<ContractionHierarchy>& hierarchy = this->directedGraph->getContractionHierarchy();
+        auto [distance, path] = hierarchy->shortestPath(source, target);
+        return ",\"distance\":" + (path.empty() ? string("null") : to_string(distance)) + ",\"path\":" + pathToJson(path)
+               + ",\"settled\":" + to_string(hierarchy->getNumberOfSettledVertices());
+    }
+
+    if (query == "benchmark")
+    {
+        expectArguments(1, 2);
+        int source = this->vertexIndex(arguments[0]);
+        int repetitions = arguments.size() == 2 ? arguments[1] : 10;
+        if (repetitions < 1)
+        {
+            throw invalid_argument("Invalid number of repetitions " + to_string(repetitions));
+        }
+
+        // Mean time of one dijkstra per queue. All runs must agree on every distance and give real shortest paths.
+        shared_ptr<const CSRGraph> snapshot = this->graph->getSnapshot();
+        bool validTrees = true;
+        auto timeQueue = [&](DijkstraQueue queue, vector<int>& D)
+        {
+            vector<int> A;
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < repetitions; i++)
+            {
+                tie(D, A) = this->graph->dijkstra(source, queue);
+            }
+            double microseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / repetitions;
+            validTrees = validTrees && isShortestPathTree(*snapshot, source, D, A);
+            return microseconds;
+        };
+        vector<int> heapDistances, radixDistances, deltaDistances;
+        double heapMicroseconds = timeQueue(DijkstraQueue::INDEXED_HEAP, heapDistances);
+        double radixMicroseconds = timeQueue(DijkstraQueue::RADIX_HEAP, radixDistances);
+        double deltaMicroseconds = timeQueue(DijkstraQueue::DELTA_STEPPING, deltaDistances);
+
+        return ",\"repetitions\":" + to_string(repetitions) + ",\"heap_us\":" + to_string(heapMicroseconds)
+               + ",\"radix_us\":" + to_string(radixMicroseconds) + ",\"speedup\":" + to_string(heapMicroseconds / radixMicroseconds)
+               + ",\"delta_us\":" + to_string(deltaMicroseconds) + ",\"delta_speedup\":" + to_string(heapMicroseconds / deltaMicroseconds)
+               + ",\"same_distances\":" + (heapDistances == radixDistances && heapDistances == deltaDistances ? "true" : "false")
+               + ",\"valid_paths\":" + (validTrees ? "true" : "false");
+    }
+
+    if (query == "scc")
+    {
+        expectArguments(0, 0);
+        needs(this->directedGraph != nullptr, "directed");
+        StronglyConnectedComponents components = this->directedGraph->stronglyConnectedComponents(true);
+        const vector<int>& sizes = components.getComponentSizes();
+        int largest = sizes.empty() ? 0 : *max_element(sizes.begin(), sizes.end());
+        return ",\"components\":" + to_string(components.getNumberOfComponents()) + ",\"largest\":" + to_string(largest)
+               + ",\"condensation_arcs\":" + to_string(components.getCondensationTargets().size());
+    }
+
+    if (query == "maxflow")
+    {
+        expectArguments(2, 2);
+        needs(this->directedGraph != nullptr, "directed");
+        int source = this->vertexIndex(arguments[0]);
+        int sink = this->vertexIndex(arguments[1]);
+        return ",\"flow\":" + to_string(this->directedGraph->edmondsKarp(source, sink));
+    }
+
+    throw invalid_argument("Unknown query " + query);
+}
+
+int QueryServer::vertexIndex(int number)
+{
+    if (number < 1 || number > this->graph->getNumberOfVertices())
+    {
+        throw invalid_argument("Invalid vertex " + to_string(number));
+    }
+    return number - 1;
+}
+
+QueryServer::~QueryServer()
+= default;
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Graph/AStar.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/Landmarks.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    const double EARTH_RADIUS = 6371008.8; // Mean radius in meters
+    const double DEGREE = M_PI / 180;
+}
+
+AStar::AStar(shared_ptr<const CSRGraph> snapshot, ArrayView<float> coordinates)
+    : heap(snapshot->getNumberOfVertices())
+{
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    if (coordinates.size() < 2 * static_cast<size_t>(numberOfVertices))
+    {
+        throw invalid_argument("A* needs coordinates for every vertex");
+    }
+    this->coordinates.assign(coordinates.begin(), coordinates.begin() + 2 * numberOfVertices);
+
+    this->geographic = true;
+    for (int v = 0; v < numberOfVertices; v++)
+    {
+        float x = this->coordinates[2 * v];
+        float y = this->coordinates[2 * v + 1];
+        if (!isfinite(x) || !isfinite(y))
+        {
+            throw invalid_argument("A* needs coordinates for every vertex");
+        }
+        this->geographic = this->geographic && fabs(x) <= 180 && fabs(y) <= 90;
+    }
+
+    this->snapshot = std::move(snapshot);
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> targets = this->snapshot->getTargets();
+    ArrayView<float> weights = this->snapshot->getWeights();
+
+    // Arcs between coinciding points say nothing about speed and are left out.
+    this->weightPerDistance = numeric_limits<double>::infinity();
+    for (int u = 0; u < numberOfVertices; u++)
+    {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            double distance = this->distanceBetween(u, targets[arc]);
+            if (distance > 0)
+            {
+                this->weightPerDistance = min(this->weightPerDistance, static_cast<int>(weights[arc]) / distance);
+            }
+        }
+    }
+    if (!isfinite(this->weightPerDistance) || this->weightPerDistance < 0)
+    {
+        this->weightPerDistance = 0;
+    }
+    this->weightPerDistance *= 1 - 1e-9; // Keeps rounding from pushing the bound over the true distance
+
+    this->prepareQueries();
+}
+
+AStar::AStar(shared_ptr<const Landmarks> landmarks)
+    : heap(landmarks->getSnapshot()->getNumberOfVertices())
+{
+    this->snapshot = landmarks->getSnapshot();
+    this->geographic = false;
+    this->weightPerDistance = 0;
+    this->landmarks = std::move(landmarks);
+    this->prepareQueries();
+}
+
+void AStar::prepareQueries()
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    this->distances = vector<int>(numberOfVertices);
+    this->parents = vector<int>(numberOfVertices);
+    this->reachedStamps = vector<uint32_t>(numberOfVertices, 0);
+    this->settledStamps = vector<uint32_t>(numberOfVertices, 0);
+    this->query = 0;
+    this->numberOfSettledVertices = 0;
+}
+
+double AStar::distanceBetween(int u, int v) const
+{
+    double x1 = this->coordinates[2 * u], y1 = this->coordinates[2 * u + 1];
+    double x2 = this->coordinates[2 * v], y2 = this->coordinates[2 * v + 1];
+    if (!this->geographic)
+    {
+        return hypot(x2 - x1, y2 - y1);
+    }
+
+    // Haversine formula
+    double latitudeDelta = (y2 - y1) * DEGREE;
+    double longitudeDelta = (x2 - x1) * DEGREE;
+    double a = sin(latitudeDelta / 2) * sin(latitudeDelta / 2)
+               + cos(y1 * DEGREE) * cos(y2 * DEGREE) * sin(longitudeDelta / 2) * sin(longitudeDelta / 2);
+    return 2 * EARTH_RADIUS * asin(min(1.0, sqrt(a)));
+}
+
+double AStar::lowerBound(int vertex, int target) const
+{
+    if (this->landmarks)
+    {
+        return this->landmarks->lowerBound(vertex, target);
+    }
+    return this->weightPerDistance * this->distanceBetween(vertex, target);
+}
+
+tuple<int, vector<int>> AStar::shortestPath(int startNodeIndex, int endNodeIndex)
+{
+    this->query++;
+    if (this->query == 0)
+    { // The stamps wrapped around, stale stamps could now match
+        fill(this->reachedStamps.begin(), this->reachedStamps.end(), 0);
+        fill(this->settledStamps.begin(), this->settledStamps.end(), 0);
+        this->query = 1;
+    }
+    this->heap.clear();
+    this->numberOfSettledVertices = 0;
+
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> targets = this->snapshot->getTargets();
+    ArrayView<float> weights = this->snapshot->getWeights();
+
+    this->reachedStamps[startNodeIndex] = this->query;
+    this->distances[startNodeIndex] = 0;
+    this->parents[startNodeIndex] = -1;
+    this->heap.push(startNodeIndex, this->lowerBound(startNodeIndex, endNodeIndex));
+
+    // The heuristic is consistent, so a vertex is final when it is popped and the search ends at the target.
+    while (!this->heap.empty())
+    {
+        int u = this->heap.pop();
+        this->settledStamps[u] = this->query;
+        this->numberOfSettledVertices++;
+        if (u == endNodeIndex)
+        {
+            break;
+        }
+
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            int v = targets[arc];
+            if (this->settledStamps[v] == this->query)
+            {
+                continue;
+            }
+            int distanceOfV = this->distances[u] + static_cast<int>(weights[arc]);
+            if (this->reachedStamps[v] != this->query || distanceOfV < this->distances[v])
+            {
+                this->reachedStamps[v] = this->query;
+                this->distances[v] = distanceOfV;
+                this->parents[v] = u;
+                this->heap.pushOrDecrease(v, distanceOfV + this->lowerBound(v, endNodeIndex));
+            }
+        }
+    }
+
+    vector<int> path;
+    if (this->settledStamps[endNodeIndex] != this->query)
+    {
+        return make_tuple(1000000, path);
+    }
+    for (int v = endNodeIndex; v != -1; v = this->parents[v])
+    {
+        path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+
+    return make_tuple(this->distances[endNodeIndex], path);
+}
+
+int AStar::getNumberOfSettledVertices() const
+{
+    return this->numberOfSettledVertices;
+}
+
+const shared_ptr<const CSRGraph>& AStar::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+AStar::~AStar()
+= default;
@@ -6,10 +6,25 @@
 #include <queue>
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <cmath>
 
 #include "Graph/AbstractGraph.h"
 #include "Graph/Node.h"
 #include "Graph/Connection.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/BidirectionalDijkstra.h"
+#include "Graph/BatchedDijkstra.h"
+#include "Graph/RadixHeap.h"
+#include "Graph/BreadthFirstSearch.h"
+#include "Graph/AStar.h"
+#include "Graph/Landmarks.h"
+#include "Graph/GraphFile.h"
 
 using namespace std;
 using namespace GraphModule;
@@ -17,6 +32,8 @@ using namespace GraphModule;
 AbstractGraph::AbstractGraph()
 {
     this->numberOfVertices = 0;
+    this->numberOfSettledVertices = 0;
+    this->storage = make_shared<GraphStorage>();
 }
 
 int AbstractGraph::getNumberOfVertices()
@@ -27,32 +44,430 @@ int AbstractGraph::getNumberOfVertices()
 vector<int> AbstractGraph::getNodeKeys()
 {
     vector<int> nodeKeys;
-    nodeKeys.reserve(this->nodes.size());
-    for (auto & node : this->nodes)
+    nodeKeys.reserve(this->storage->getNumberOfNodes());
+    for (const auto & node : this->storage->getNodes())
         {
             nodeKeys.push_back(node->getNumber());
         }
     return nodeKeys;
 }
 
-vector<shared_ptr<Node>> AbstractGraph::getNodes()
+const vector<shared_ptr<Node>>& AbstractGraph::getNodes()
 {
-    return this->nodes;
+    return this->storage->getNodes();
 }
 
 void AbstractGraph::addNode(const shared_ptr<Node>& node)
 {
-    this->nodes.push_back(node);
+    this->storage->addNode(node);
     this->numberOfVertices++;
 }
 
+void AbstractGraph::reserve(int numberOfVertices, int numberOfConnections)
+{
+    this->storage->reserve(numberOfVertices, numberOfConnections);
+}
+
 void AbstractGraph::showNodes()
 {
-    for (auto & node : this->nodes)
+    for (const auto & node : this->storage->getNodes())
     {
         cout << "Vertex name " << node->getName() << " with number " << node->getNumber() << endl;
     }
 }
 
+void AbstractGraph::load(shared_ptr<const GraphFile> file)
+{
+    if (file->isDirected() != this->isDirected())
+    {
+        throw invalid_argument("Graph needs to be " + string(this->isDirected() ? "directed" : "undirected"));
+    }
+    this->storage->load(file);
+    this->numberOfVertices = file->getNumberOfVertices();
+    this->loadConnections(*file);
+}
+
+shared_ptr<const CSRGraph> AbstractGraph::getSnapshot()
+{
+    return this->storage->getSnapshot(this->isDirected());
+}
+
+GraphStorage& AbstractGraph::getStorage()
+{
+    return *this->storage;
+}
+
+BreadthFirstSearch AbstractGraph::breadthFirstLevels(int startNodeIndex)
+{
+    return BreadthFirstSearch(this->getSnapshot(), startNodeIndex);
+}
+
+tuple<vector<int>, vector<int>> AbstractGraph::dijkstra(int startNodeIndex, DijkstraQueue queue)
+{
+    if (queue == DijkstraQueue::RADIX_HEAP)
+    {
+        return this->radixHeapDijkstra(startNodeIndex);
+    }
+    if (queue == DijkstraQueue::DELTA_STEPPING)
+    {
+        return this->deltaStepping(startNodeIndex);
+    }
+
+    // The workspace behind it is kept between calls, so a call only pays for the vertices it reaches and the result.
+    return this->getBatchedDijkstra().run(startNodeIndex);
+}
+
+tuple<vector<int>, vector<int>> AbstractGraph::radixHeapDijkstra(int startNodeIndex)
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets();
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+    ArrayView<float> weights = snapshot->getWeights();
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    if (startNodeIndex < 0 || startNodeIndex >= numberOfVertices)
+    {
+        throw invalid_argument("Invalid start vertex " + to_string(startNodeIndex));
+    }
+    vector<int> D(numberOfVertices, 1000000); // Vector of distances from the start node, initialized with infinity.
+    vector<int> A(numberOfVertices, -1); // Vector of parent nodes.
+    vector<bool> C(numberOfVertices, false); // Vector of visited nodes.
+
+    for (float weight : weights)
+    {
+        if (static_cast<int>(weight) < 0)
+        {
+            throw invalid_argument("The radix heap needs non-negative weights");
+        }
+    }
+
+    D[startNodeIndex] = 0;
+
+    // Distances popped never decrease, which is all the radix heap asks for. An improved vertex is pushed again
+    // and its older entries are skipped once it is visited.
+    RadixHeap<int> heap;
+    heap.push(0, startNodeIndex);
+
+    while (!heap.empty())
+    {
+        int u = heap.pop().second;
+        if (C[u])
+        {
+            continue;
+        }
+        C[u] = true;
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            int v = targets[arc];
+            if (!C[v])
+            {
+                int w = weights[arc];
+                if (D[v] > D[u] + w)
+                {
+                    D[v] = D[u] + w;
+                    A[v] = u;
+                    heap.push(D[v], v);
+                }
+            }
+        }
+    }
+
+    return make_tuple(D, A);
+}
+
+tuple<vector<int>, vector<int>> AbstractGraph::deltaStepping(int startNodeIndex, int delta)
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets();
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+    ArrayView<float> weights = snapshot->getWeights();
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    if (startNodeIndex < 0 || startNodeIndex >= numberOfVertices)
+    {
+        throw invalid_argument("Invalid start vertex " + to_string(startNodeIndex));
+    }
+    const int INFINITE_DISTANCE = 1000000; // Same infinity as dijkstra, distances from it on are never stored
+    const uint32_t NO_PARENT = UINT32_MAX;
+    const int PARALLEL_GRAIN = 1024; // Smaller batches run on the calling thread
+
+    long long totalWeight = 0;
+    for (float weight : weights)
+    {
+        if (static_cast<int>(weight) < 0)
+        {
+            throw invalid_argument("Delta-stepping needs non-negative weights");
+        }
+        totalWeight += static_cast<int>(weight);
+    }
+    if (delta <= 0)
+    { // The mean weight keeps most arcs light without collapsing the buckets into one
+        delta = weights.empty() ? 1 : max(1LL, totalWeight / static_cast<long long>(weights.size()));
+    }
+
+    // Distance and parent packed in one word, so a single compare-and-swap lowers both together.
+    auto pack = [](int distance, uint32_t parent)
+    {
+        return (static_cast<uint64_t>(distance) << 32) | parent;
+    };
+    vector<atomic<uint64_t>> labels(numberOfVertices);
+    for (atomic<uint64_t>& label : labels)
+    {
+        label.store(pack(INFINITE_DISTANCE, NO_PARENT), memory_order_relaxed);
+    }
+    labels[startNodeIndex].store(pack(0, NO_PARENT), memory_order_relaxed);
+    auto distanceOf = [&labels](int v)
+    {
+        return static_cast<int>(labels[v].load(memory_order_relaxed) >> 32);
+    };
+
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    auto parallelFor = [numberOfThreads, PARALLEL_GRAIN](int count, const function<void(int, int, int)>& work)
+    {
+        if (numberOfThreads == 1 || count < PARALLEL_GRAIN)
+        {
+            work(0, 0, count);
+            return;
+        }
+        vector<thread> threads;
+        int blockSize = (count + numberOfThreads - 1) / numberOfThreads;
+        for (int t = 0; t < numberOfThreads && t * blockSize < count; t++)
+        {
+            threads.emplace_back(work, t, t * blockSize, min(count, (t + 1) * blockSize));
+        }
+        for (thread& worker : threads)
+        {
+            worker.join();
+        }
+    };
+
+    // Relaxes the light (weight <= delta) or the heavy arcs of the given vertices and files every lowered vertex in its
+    // bucket. A vertex may sit in several buckets, the stale copies are skipped when their bucket is taken.
+    vector<vector<int>> buckets(1, vector<int>(1, startNodeIndex));
+    vector<vector<int>> lowered(numberOfThreads);
+    auto relaxArcs = [&](const vector<int>& vertices, bool light)
+    {
+        parallelFor(vertices.size(), [&](int t, int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                int u = vertices[i];
+                int distanceOfU = distanceOf(u);
+                for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+                {
+                    int w = weights[arc];
+                    if ((w <= delta) != light)
+                    {
+                        continue;
+                    }
+                    int v = targets[arc];
+                    int distanceOfV = distanceOfU + w;
+                    uint64_t current = labels[v].load(memory_order_relaxed);
+                    while (distanceOfV < static_cast<int>(current >> 32))
+                    {
+                        if (labels[v].compare_exchange_weak(current, pack(distanceOfV, u), memory_order_relaxed))
+                        {
+                            lowered[t].push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+
+        for (vector<int>& vertices : lowered)
+        {
+            for (int v : vertices)
+            {
+                size_t bucket = distanceOf(v) / delta;
+                if (bucket >= buckets.size())
+                {
+                    buckets.resize(bucket + 1);
+                }
+                buckets[bucket].push_back(v);
+            }
+            vertices.clear();
+        }
+    };
+
+    vector<uint32_t> phaseStamps(numberOfVertices, 0);
+    vector<uint32_t> bucketStamps(numberOfVertices, 0);
+    uint32_t phase = 0;
+    for (size_t bucket = 0; bucket < buckets.size(); bucket++)
+    {
+        // Light arcs can refill the current bucket, so it is emptied in phases. Heavy arcs always leave it and are
+        // relaxed once, from every vertex it held.
+        vector<int> settled;
+        while (!buckets[bucket].empty())
+        {
+            vector<int> entries;
+            entries.swap(buckets[bucket]);
+            phase++;
+            vector<int> frontier;
+            for (int v : entries)
+            {
+                if (static_cast<size_t>(distanceOf(v) / delta) == bucket && phaseStamps[v] != phase)
+                {
+                    phaseStamps[v] = phase;
+                    frontier.push_back(v);
+                    if (bucketStamps[v] != bucket + 1)
+                    {
+                        bucketStamps[v] = bucket + 1;
+                        settled.push_back(v);
+                    }
+                }
+            }
+            relaxArcs(frontier, true);
+        }
+        relaxArcs(settled, false);
+    }
+
+    vector<int> D(numberOfVertices);
+    vector<int> A(numberOfVertices);
+    for (int v = 0; v < numberOfVertices; v++)
+    {
+        uint64_t label = labels[v].load(memory_order_relaxed);
+        D[v] = static_cast<int>(label >> 32);
+        A[v] = static_cast<uint32_t>(label) == NO_PARENT ? -1 : static_cast<int>(static_cast<uint32_t>(label));
+    }
+
+    // Which of several tight parents won the race depends on timing, so the parent is settled afterwards: the first
+    // in-neighbour on a shortest path that is strictly closer. Undirected snapshots give the forward rows as reverse ones.
+    ArrayView<uint32_t> reverseOffsets = snapshot->getReverseOffsets();
+    ArrayView<uint32_t> sources = snapshot->getSources();
+    ArrayView<float> reverseWeights = snapshot->getReverseWeights();
+    vector<char> anchored(numberOfVertices, 0);
+    anchored[startNodeIndex] = 1;
+    parallelFor(numberOfVertices, [&](int, int begin, int end)
+    {
+        for (int v = begin; v < end; v++)
+        {
+            if (v == startNodeIndex || D[v] >= INFINITE_DISTANCE)
+            {
+                continue;
+            }
+            for (uint32_t arc = reverseOffsets[v]; arc < reverseOffsets[v + 1]; arc++)
+            {
+                int u = sources[arc];
+                if (D[u] < D[v] && D[u] + static_cast<int>(reverseWeights[arc]) == D[v])
+                {
+                    A[v] = u;
+                    anchored[v] = 1;
+                    break;
+                }
+            }
+        }
+    });
+
+    // The others are only reached over zero weight arcs from vertices as close as them. A search over those arcs from the
+    // anchored vertices, in index order, gives them parents without cycles.
+    bool zeroWeightTies = false;
+    for (int v = 0; v < numberOfVertices && !zeroWeightTies; v++)
+    {
+        zeroWeightTies = D[v] < INFINITE_DISTANCE && !anchored[v];
+    }
+    if (zeroWeightTies)
+    {
+        vector<int> queue;
+        for (int v = 0; v < numberOfVertices; v++)
+        {
+            if (anchored[v] && D[v] < INFINITE_DISTANCE)
+            {
+                queue.push_back(v);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            int u = queue[head];
+            for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+            {
+                int v = targets[arc];
+                if (!anchored[v] && static_cast<int>(weights[arc]) == 0 && D[v] == D[u])
+                {
+                    A[v] = u;
+                    anchored[v] = 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+
+    return make_tuple(D, A);
+}
+
+tuple<int, vector<int>> AbstractGraph::shortestPath(int startNodeIndex, int endNodeIndex)
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!this->pointToPoint || this->pointToPoint->getSnapshot() != snapshot)
+    {
+        this->pointToPoint = make_shared<BidirectionalDijkstra>(snapshot);
+    }
+    tuple<int, vector<int>> result = this->pointToPoint->shortestPath(startNodeIndex, endNodeIndex);
+    this->numberOfSettledVertices = this->pointToPoint->getNumberOfSettledVertices();
+    return result;
+}
+
+BatchedDijkstra& AbstractGraph::getBatchedDijkstra()
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!this->manySources || this->manySources->getSnapshot() != snapshot)
+    {
+        this->manySources = make_shared<BatchedDijkstra>(snapshot);
+    }
+    return *this->manySources;
+}
+
+ShortestPathTrees AbstractGraph::shortestPathTrees(const vector<int>& startNodeIndexes)
+{
+    return this->getBatchedDijkstra().run(startNodeIndexes);
+}
+
+tuple<int, vector<int>> AbstractGraph::aStar(int startNodeIndex, int endNodeIndex)
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!this->goalDirected || this->goalDirected->getSnapshot() != snapshot)
+    {
+        this->goalDirected = make_shared<AStar>(snapshot, this->storage->getCoordinates());
+    }
+    tuple<int, vector<int>> result = this->goalDirected->shortestPath(startNodeIndex, endNodeIndex);
+    this->numberOfSettledVertices = this->goalDirected->getNumberOfSettledVertices();
+    return result;
+}
+
+const shared_ptr<Landmarks>& AbstractGraph::getLandmarks()
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!this->landmarks || this->landmarks->getSnapshot() != snapshot)
+    {
+        this->landmarks = make_shared<Landmarks>(snapshot, min(16, max(1, snapshot->getNumberOfVertices())));
+    }
+    return this->landmarks;
+}
+
+void AbstractGraph::setLandmarks(shared_ptr<Landmarks> landmarks)
+{
+    if (landmarks->getSnapshot() != this->getSnapshot())
+    {
+        throw invalid_argument("The landmarks belong to another snapshot of the graph");
+    }
+    this->landmarks = std::move(landmarks);
+    this->landmarkDirected.reset();
+}
+
+tuple<int, vector<int>> AbstractGraph::landmarkAStar(int startNodeIndex, int endNodeIndex)
+{
+    const shared_ptr<Landmarks>& landmarks = this->getLandmarks();
+    if (!this->landmarkDirected || this->landmarkDirected->getSnapshot() != landmarks->getSnapshot())
+    {
+        this->landmarkDirected = make_shared<AStar>(landmarks);
+    }
+    tuple<int, vector<int>> result = this->landmarkDirected->shortestPath(startNodeIndex, endNodeIndex);
+    this->numberOfSettledVertices = this->landmarkDirected->getNumberOfSettledVertices();
+    return result;
+}
+
+int AbstractGraph::getNumberOfSettledVertices()
+{
+    return this->numberOfSettledVertices;
+}
+
 AbstractGraph::~AbstractGraph()
 = default;
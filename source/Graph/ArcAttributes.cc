@@ -0,0 +1,213 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include "Graph/ArcAttributes.h"
+#include "Graph/MappedFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    // Next token of an attribute tail. A token opened by a quote runs to the closing quote, so quoted names may hold blanks.
+    string_view nextToken(string_view& text)
+    {
+        size_t begin = 0;
+        while (begin < text.size() && isBlank(text[begin]))
+        {
+            begin++;
+        }
+
+        size_t end = begin;
+        if (end < text.size() && text[end] == '"')
+        {
+            size_t closingQuote = text.find('"', end + 1);
+            end = closingQuote == string_view::npos ? text.size() : closingQuote + 1;
+        }
+        else
+        {
+            while (end < text.size() && !isBlank(text[end]))
+            {
+                end++;
+            }
+        }
+
+        string_view token = text.substr(begin, end - begin);
+        text.remove_prefix(end);
+        return token;
+    }
+
+    // Leading number of a value such as "2" or "2;3", clamped to a byte. Anything else is unknown.
+    uint8_t parseSmallNumber(string_view value)
+    {
+        int number = 0;
+        auto result = from_chars(value.data(), value.data() + value.size(), number);
+        if (result.ec != errc() || number <= 0)
+        {
+            return ArcAttributes::UNKNOWN;
+        }
+        return min(number, 255);
+    }
+}
+
+ArcAttributes::ArcAttributes(shared_ptr<const MappedFile> source, vector<Tail> tails)
+{
+    this->source = std::move(source);
+    this->tails = std::move(tails);
+}
+
+uint32_t ArcAttributes::getNumberOfConnections() const
+{
+    return this->tails.size();
+}
+
+string_view ArcAttributes::getTail(uint32_t connection) const
+{
+    if (connection >= this->tails.size())
+    {
+        return {};
+    }
+    const Tail& tail = this->tails[connection];
+    return string_view(this->source->data() + tail.position, tail.length);
+}
+
+string_view ArcAttributes::findValue(string_view tail, string_view key)
+{
+    // Tails are key value pairs. Values are skipped as whole tokens so that a name never matches a key.
+    while (true)
+    {
+        string_view currentKey = nextToken(tail);
+        if (currentKey.empty())
+        {
+            return {};
+        }
+        string_view value = nextToken(tail);
+        if (currentKey == key)
+        {
+            return value;
+        }
+    }
+}
+
+string ArcAttributes::getAttribute(uint32_t connection, const string& key) const
+{
+    string_view value = findValue(this->getTail(connection), key);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    {
+        value = value.substr(1, value.size() - 2);
+    }
+    return string(value);
+}
+
+template <typename ParseValue>
+vector<uint8_t> ArcAttributes::parseColumn(string_view key, ParseValue parseValue) const
+{
+    vector<uint8_t> column(this->tails.size(), UNKNOWN);
+    for (uint32_t connection = 0; connection < this->tails.size(); connection++)
+    {
+        string_view value = findValue(this->getTail(connection), key);
+        if (!value.empty())
+        {
+            column[connection] = parseValue(value);
+        }
+    }
+    return column;
+}
+
+const vector<uint8_t>& ArcAttributes::getHighways()
+{
+    if (this->highways.empty() && !this->tails.empty())
+    {
+        this->highwayNames = {""};
+        this->highways = this->parseColumn("highway", [this](string_view value)
+        {
+            auto found = find(this->highwayNames.begin(), this->highwayNames.end(), value);
+            if (found != this->highwayNames.end())
+            {
+                return static_cast<uint8_t>(found - this->highwayNames.begin());
+            }
+            if (this->highwayNames.size() > 255)
+            {
+                throw runtime_error("More than 255 highway classes in " + this->source->getPath());
+            }
+            this->highwayNames.emplace_back(value);
+            return static_cast<uint8_t>(this->highwayNames.size() - 1);
+        });
+    }
+    return this->highways;
+}
+
+uint8_t ArcAttributes::getHighway(uint32_t connection)
+{
+    const vector<uint8_t>& column = this->getHighways();
+    return connection < column.size() ? column[connection] : UNKNOWN;
+}
+
+const string& ArcAttributes::getHighwayName(uint8_t highway) const
+{
+    static const string unknown;
+    return highway < this->highwayNames.size() ? this->highwayNames[highway] : unknown;
+}
+
+uint8_t ArcAttributes::findHighway(const string& highwayName) const
+{
+    auto found = find(this->highwayNames.begin(), this->highwayNames.end(), highwayName);
+    return found == this->highwayNames.end() ? UNKNOWN : found - this->highwayNames.begin();
+}
+
+const vector<uint8_t>& ArcAttributes::getLanes()
+{
+    if (this->lanes.empty() && !this->tails.empty())
+    {
+        this->lanes = this->parseColumn("lanes", parseSmallNumber);
+    }
+    return this->lanes;
+}
+
+const vector<uint8_t>& ArcAttributes::getMaxSpeeds()
+{
+    if (this->maxSpeeds.empty() && !this->tails.empty())
+    {
+        this->maxSpeeds = this->parseColumn("maxspeed", parseSmallNumber);
+    }
+    return this->maxSpeeds;
+}
+
+const vector<uint8_t>& ArcAttributes::getOneways()
+{
+    if (this->oneways.empty() && !this->tails.empty())
+    {
+        this->oneways = this->parseColumn("oneway", [](string_view value)
+        {
+            if (value == "yes" || value == "true" || value == "1")
+            {
+                return static_cast<uint8_t>(ONEWAY_YES);
+            }
+            if (value == "no" || value == "false" || value == "0")
+            {
+                return static_cast<uint8_t>(ONEWAY_NO);
+            }
+            if (value == "-1" || value == "reverse")
+            {
+                return static_cast<uint8_t>(ONEWAY_REVERSE);
+            }
+            return static_cast<uint8_t>(ONEWAY_UNKNOWN);
+        });
+    }
+    return this->oneways;
+}
+
+ArcAttributes::~ArcAttributes()
+= default;
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph/BatchedDijkstra.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+BatchedDijkstra::BatchedDijkstra(shared_ptr<const CSRGraph> snapshot)
+{
+    this->snapshot = std::move(snapshot);
+}
+
+DijkstraWorkspace& BatchedDijkstra::getWorkspace(int index)
+{
+    while (static_cast<int>(this->workspaces.size()) <= index)
+    {
+        this->workspaces.push_back(make_unique<DijkstraWorkspace>(this->snapshot));
+    }
+    return *this->workspaces[index];
+}
+
+ShortestPathTrees BatchedDijkstra::run(const vector<int>& sources)
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    for (int source : sources)
+    {
+        if (source < 0 || source >= numberOfVertices)
+        {
+            throw invalid_argument("Invalid start vertex " + to_string(source));
+        }
+    }
+
+    ShortestPathTrees trees(sources, numberOfVertices);
+    int numberOfTrees = sources.size();
+    if (numberOfTrees == 0)
+    {
+        return trees;
+    }
+    int numberOfThreads = min(numberOfTrees, static_cast<int>(max(1u, thread::hardware_concurrency())));
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        this->getWorkspace(t); // Made here, so the threads never grow the vector
+    }
+
+    atomic<int> next(0);
+    auto work = [this, &trees, &sources, &next, numberOfTrees](int t)
+    {
+        DijkstraWorkspace& workspace = *this->workspaces[t];
+        for (int tree = next++; tree < numberOfTrees; tree = next++)
+        {
+            workspace.run(sources[tree]);
+            workspace.copyTo(trees.distanceRow(tree), trees.parentRow(tree));
+        }
+    };
+
+    if (numberOfThreads <= 1)
+    {
+        work(0);
+        return trees;
+    }
+    vector<thread> threads;
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        threads.emplace_back(work, t);
+    }
+    for (thread& worker : threads)
+    {
+        worker.join();
+    }
+
+    return trees;
+}
+
+tuple<vector<int>, vector<int>> BatchedDijkstra::run(int source)
+{
+    DijkstraWorkspace& workspace = this->getWorkspace(0);
+    workspace.run(source);
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    vector<int> D(numberOfVertices);
+    vector<int> A(numberOfVertices);
+    workspace.copyTo(D.data(), A.data());
+    return make_tuple(std::move(D), std::move(A));
+}
+
+const shared_ptr<const CSRGraph>& BatchedDijkstra::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+BatchedDijkstra::~BatchedDijkstra()
+= default;
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <climits>
+
+#include "Graph/BidirectionalDijkstra.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+BidirectionalDijkstra::BidirectionalDijkstra(shared_ptr<const CSRGraph> snapshot)
+    : heaps{IndexedHeap<int>(snapshot->getNumberOfVertices()), IndexedHeap<int>(snapshot->getNumberOfVertices())}
+{
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    for (int side : {FORWARD, BACKWARD})
+    {
+        this->distances[side] = vector<int>(numberOfVertices);
+        this->parents[side] = vector<int>(numberOfVertices);
+        this->reachedStamps[side] = vector<uint32_t>(numberOfVertices, 0);
+        this->settledStamps[side] = vector<uint32_t>(numberOfVertices, 0);
+    }
+    this->snapshot = std::move(snapshot);
+    this->query = 0;
+    this->numberOfSettledVertices = 0;
+}
+
+void BidirectionalDijkstra::reach(int side, int vertex, int distance, int parent)
+{
+    this->reachedStamps[side][vertex] = this->query;
+    this->distances[side][vertex] = distance;
+    this->parents[side][vertex] = parent;
+    this->heaps[side].pushOrDecrease(vertex, distance);
+}
+
+bool BidirectionalDijkstra::isReached(int side, int vertex) const
+{
+    return this->reachedStamps[side][vertex] == this->query;
+}
+
+tuple<int, vector<int>> BidirectionalDijkstra::shortestPath(int startNodeIndex, int endNodeIndex)
+{
+    this->query++;
+    if (this->query == 0)
+    { // The stamps wrapped around, stale stamps could now match
+        for (int side : {FORWARD, BACKWARD})
+        {
+            fill(this->reachedStamps[side].begin(), this->reachedStamps[side].end(), 0);
+            fill(this->settledStamps[side].begin(), this->settledStamps[side].end(), 0);
+        }
+        this->query = 1;
+    }
+    this->heaps[FORWARD].clear();
+    this->heaps[BACKWARD].clear();
+    this->numberOfSettledVertices = 0;
+
+    ArrayView<uint32_t> offsets[2] = {this->snapshot->getOffsets(), this->snapshot->getReverseOffsets()};
+    ArrayView<uint32_t> neighbours[2] = {this->snapshot->getTargets(), this->snapshot->getSources()};
+    ArrayView<float> weights[2] = {this->snapshot->getWeights(), this->snapshot->getReverseWeights()};
+
+    int best = INT_MAX; // Length of the best path seen, unbounded until the balls meet so long paths are not cut off
+    int meeting = -1;
+    if (startNodeIndex == endNodeIndex)
+    {
+        best = 0;
+        meeting = startNodeIndex;
+    }
+
+    this->reach(FORWARD, startNodeIndex, 0, -1);
+    this->reach(BACKWARD, endNodeIndex, 0, -1);
+
+    while (!this->heaps[FORWARD].empty() && !this->heaps[BACKWARD].empty())
+    {
+        int forwardFrontier = this->heaps[FORWARD].topPriority();
+        int backwardFrontier = this->heaps[BACKWARD].topPriority();
+        if (static_cast<long long>(forwardFrontier) + backwardFrontier >= best)
+        {
+            break; // Any path through an unsettled vertex is at least as long as the best one
+        }
+
+        int side = forwardFrontier <= backwardFrontier ? FORWARD : BACKWARD;
+        int other = 1 - side;
+        int u = this->heaps[side].pop();
+        this->settledStamps[side][u] = this->query;
+        this->numberOfSettledVertices++;
+
+        int distanceOfU = this->distances[side][u];
+        for (uint32_t arc = offsets[side][u]; arc < offsets[side][u + 1]; arc++)
+        {
+            int v = neighbours[side][arc];
+            if (this->settledStamps[side][v] == this->query)
+            {
+                continue;
+            }
+            int w = weights[side][arc];
+            int distanceOfV = distanceOfU + w;
+            if (!this->isReached(side, v) || distanceOfV < this->distances[side][v])
+            {
+                this->reach(side, v, distanceOfV, u);
+            }
+            if (this->isReached(other, v) && this->distances[side][v] + this->distances[other][v] < best)
+            {
+                best = this->distances[side][v] + this->distances[other][v];
+                meeting = v;
+            }
+        }
+    }
+
+    vector<int> path;
+    if (meeting == -1)
+    {
+        return make_tuple(1000000, path); // Unreachable, reported as A* does
+    }
+    for (int v = meeting; v != -1; v = this->parents[FORWARD][v])
+    {
+        path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+    for (int v = this->parents[BACKWARD][meeting]; v != -1; v = this->parents[BACKWARD][v])
+    {
+        path.push_back(v);
+    }
+
+    return make_tuple(best, path);
+}
+
+int BidirectionalDijkstra::getNumberOfSettledVertices() const
+{
+    return this->numberOfSettledVertices;
+}
+
+const shared_ptr<const CSRGraph>& BidirectionalDijkstra::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+BidirectionalDijkstra::~BidirectionalDijkstra()
+= default;
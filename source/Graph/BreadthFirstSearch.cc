@@ -0,0 +1,248 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph/BreadthFirstSearch.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+BreadthFirstSearch::BreadthFirstSearch(shared_ptr<const CSRGraph> snapshot, int startNodeIndex)
+    : visited((snapshot->getNumberOfVertices() + 63) / 64)
+{
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    if (startNodeIndex < 0 || startNodeIndex >= numberOfVertices)
+    {
+        throw invalid_argument("Invalid start vertex " + to_string(startNodeIndex));
+    }
+    this->snapshot = std::move(snapshot);
+    this->startNodeIndex = startNodeIndex;
+    this->distances = vector<int>(numberOfVertices, INFINITE_DISTANCE);
+    this->parents = vector<int>(numberOfVertices, -1);
+    for (atomic<uint64_t>& word : this->visited)
+    {
+        word.store(0, memory_order_relaxed);
+    }
+    this->frontier = vector<uint64_t>(this->visited.size());
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    this->found = vector<vector<int>>(numberOfThreads);
+    this->numberOfBottomUpSteps = 0;
+
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> reverseOffsets = this->snapshot->getReverseOffsets();
+    auto degree = [&offsets](int v)
+    {
+        return static_cast<long long>(offsets[v + 1] - offsets[v]);
+    };
+    auto inDegree = [&reverseOffsets](int v)
+    {
+        return static_cast<long long>(reverseOffsets[v + 1] - reverseOffsets[v]);
+    };
+
+    this->claim(startNodeIndex);
+    this->distances[startNodeIndex] = 0;
+    this->levelVertices.reserve(numberOfVertices);
+    this->levelVertices.push_back(startNodeIndex);
+    this->levelOffsets = {0, 1};
+
+    // Arcs into vertices not yet visited, which is what a bottom-up step may have to look at.
+    long long unexploredArcs = reverseOffsets[numberOfVertices] - inDegree(startNodeIndex);
+    bool bottomUp = false;
+    int previousSize = 0;
+    for (int level = 0; ; level++)
+    {
+        int begin = this->levelOffsets[level];
+        int end = this->levelOffsets[level + 1];
+        int size = end - begin;
+        long long frontierArcs = 0;
+        for (int i = begin; i < end; i++)
+        {
+            frontierArcs += degree(this->levelVertices[i]);
+        }
+
+        // Bottom-up pays off while the frontier is heavy against what is left, and stops paying once it shrinks.
+        if (!bottomUp)
+        {
+            bottomUp = frontierArcs > unexploredArcs / ALPHA;
+        }
+        else
+        {
+            bottomUp = size >= numberOfVertices / BETA || size >= previousSize;
+        }
+        previousSize = size;
+
+        if (bottomUp)
+        {
+            this->numberOfBottomUpSteps++;
+            this->bottomUpStep(level, numberOfVertices < PARALLEL_GRAIN ? 1 : numberOfThreads);
+        }
+        else
+        {
+            this->topDownStep(level, frontierArcs < PARALLEL_GRAIN ? 1 : numberOfThreads);
+        }
+
+        if (static_cast<int>(this->levelVertices.size()) == end)
+        {
+            break; // Nothing new, the last level was the deepest
+        }
+        for (size_t i = end; i < this->levelVertices.size(); i++)
+        {
+            unexploredArcs -= inDegree(this->levelVertices[i]);
+        }
+        this->levelOffsets.push_back(this->levelVertices.size());
+    }
+}
+
+bool BreadthFirstSearch::isVisited(int vertex) const
+{
+    return (this->visited[vertex >> 6].load(memory_order_relaxed) >> (vertex & 63)) & 1;
+}
+
+bool BreadthFirstSearch::claim(int vertex)
+{
+    uint64_t bit = 1ULL << (vertex & 63);
+    return !(this->visited[vertex >> 6].fetch_or(bit, memory_order_relaxed) & bit);
+}
+
+int BreadthFirstSearch::topDownStep(int level, int numberOfThreads)
+{
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> targets = this->snapshot->getTargets();
+    const int* frontierVertices = this->levelVertices.data() + this->levelOffsets[level];
+    int size = this->levelOffsets[level + 1] - this->levelOffsets[level];
+
+    // The bit is read before the atomic claim, since most arcs lead to vertices visited long ago.
+    this->parallelFor(size, numberOfThreads, [&](int t, int begin, int end)
+    {
+        vector<int>& found = this->found[t];
+        for (int i = begin; i < end; i++)
+        {
+            int u = frontierVertices[i];
+            for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+            {
+                int v = targets[arc];
+                if (!this->isVisited(v) && this->claim(v))
+                {
+                    this->distances[v] = level + 1;
+                    this->parents[v] = u;
+                    found.push_back(v);
+                }
+            }
+        }
+    });
+
+    size_t first = this->levelVertices.size();
+    for (vector<int>& found : this->found)
+    {
+        this->levelVertices.insert(this->levelVertices.end(), found.begin(), found.end());
+        found.clear();
+    }
+    sort(this->levelVertices.begin() + first, this->levelVertices.end());
+    return this->levelVertices.size() - first;
+}
+
+int BreadthFirstSearch::bottomUpStep(int level, int numberOfThreads)
+{
+    // A vertex joins the level through an arc into it, so the reverse rows are scanned, the forward ones when undirected.
+    ArrayView<uint32_t> offsets = this->snapshot->getReverseOffsets();
+    ArrayView<uint32_t> sources = this->snapshot->getSources();
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+
+    fill(this->frontier.begin(), this->frontier.end(), 0);
+    for (int i = this->levelOffsets[level]; i < this->levelOffsets[level + 1]; i++)
+    {
+        int u = this->levelVertices[i];
+        this->frontier[u >> 6] |= 1ULL << (u & 63);
+    }
+
+    // Whole words of the visited bitmap are skipped at once, so the late steps mostly stream through the bitmap. Every
+    // thread owns its words, found vertices are marked once per word.
+    this->parallelFor(numberOfVertices, numberOfThreads, [&](int t, int begin, int end)
+    {
+        vector<int>& found = this->found[t];
+        for (int word = begin >> 6; word << 6 < end; word++)
+        {
+            uint64_t unvisited = ~this->visited[word].load(memory_order_relaxed);
+            uint64_t reached = 0;
+            while (unvisited != 0)
+            {
+                int bit = __builtin_ctzll(unvisited);
+                unvisited &= unvisited - 1;
+                int v = (word << 6) + bit;
+                if (v >= end)
+                {
+                    break;
+                }
+                for (uint32_t arc = offsets[v]; arc < offsets[v + 1]; arc++)
+                {
+                    int u = sources[arc];
+                    if ((this->frontier[u >> 6] >> (u & 63)) & 1)
+                    {
+                        this->distances[v] = level + 1;
+                        this->parents[v] = u;
+                        reached |= 1ULL << bit;
+                        found.push_back(v);
+                        break;
+                    }
+                }
+            }
+            if (reached != 0)
+            {
+                this->visited[word].fetch_or(reached, memory_order_relaxed);
+            }
+        }
+    });
+
+    // Blocks are in vertex order, so the level comes out sorted.
+    size_t first = this->levelVertices.size();
+    for (vector<int>& found : this->found)
+    {
+        this->levelVertices.insert(this->levelVertices.end(), found.begin(), found.end());
+        found.clear();
+    }
+    return this->levelVertices.size() - first;
+}
+
+int BreadthFirstSearch::getStartNodeIndex() const
+{
+    return this->startNodeIndex;
+}
+
+const vector<int>& BreadthFirstSearch::getDistances() const
+{
+    return this->distances;
+}
+
+const vector<int>& BreadthFirstSearch::getParents() const
+{
+    return this->parents;
+}
+
+int BreadthFirstSearch::getNumberOfLevels() const
+{
+    return this->levelOffsets.size() - 1;
+}
+
+const vector<int>& BreadthFirstSearch::getLevelOffsets() const
+{
+    return this->levelOffsets;
+}
+
+const vector<int>& BreadthFirstSearch::getLevelVertices() const
+{
+    return this->levelVertices;
+}
+
+int BreadthFirstSearch::getNumberOfBottomUpSteps() const
+{
+    return this->numberOfBottomUpSteps;
+}
+
+BreadthFirstSearch::~BreadthFirstSearch()
+= default;
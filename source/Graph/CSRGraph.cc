@@ -0,0 +1,212 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <cstring>
+
+#include "Graph/CSRGraph.h"
+#include "Graph/AbstractGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/GraphFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+CSRGraph::CSRGraph()
+{
+    this->numberOfVertices = 0;
+    this->directed = false;
+    this->offsets = vector<uint32_t>(1, 0);
+    this->viewArrays();
+}
+
+CSRGraph::CSRGraph(AbstractGraph& graph)
+    : CSRGraph(graph.getStorage(), graph.isDirected())
+{
+}
+
+CSRGraph::CSRGraph(const GraphStorage& storage, bool directed)
+{
+    this->numberOfVertices = storage.getNumberOfNodes();
+    this->directed = directed;
+    this->offsets = vector<uint32_t>(this->numberOfVertices + 1, 0);
+    this->targets.reserve(storage.getNumberOfConnections());
+    this->weights.reserve(storage.getNumberOfConnections());
+
+    // Undirected graphs store one connection per endpoint, so the outgoing chains hold every row.
+    for (int u = 0; u < this->numberOfVertices; u++)
+    {
+        for (uint32_t conn = storage.firstOutgoing(u); conn != GraphStorage::NONE; conn = storage.nextOutgoing(conn))
+        {
+            this->targets.push_back(storage.getEndNode(conn));
+            this->weights.push_back(storage.getWeight(conn));
+        }
+        this->offsets[u + 1] = this->targets.size();
+    }
+
+    this->buildReverse();
+    this->viewArrays();
+}
+
+CSRGraph::CSRGraph(int numberOfVertices, bool directed, vector<uint32_t> offsets, vector<uint32_t> targets, vector<float> weights)
+{
+    this->numberOfVertices = numberOfVertices;
+    this->directed = directed;
+    this->offsets = std::move(offsets);
+    this->targets = std::move(targets);
+    this->weights = std::move(weights);
+
+    this->buildReverse();
+    this->viewArrays();
+}
+
+CSRGraph::CSRGraph(shared_ptr<const GraphFile> file)
+{
+    // The file keeps the reverse rows of directed graphs too, so nothing is built here.
+    uint32_t numberOfArcs = file->getNumberOfArcs();
+    this->numberOfVertices = file->getNumberOfVertices();
+    this->directed = file->isDirected();
+    this->offsetsView = ArrayView<uint32_t>(file->getOffsets(), this->numberOfVertices + 1);
+    this->targetsView = ArrayView<uint32_t>(file->getTargets(), numberOfArcs);
+    this->weightsView = ArrayView<float>(file->getWeights(), numberOfArcs);
+    if (this->directed)
+    {
+        this->reverseOffsetsView = ArrayView<uint32_t>(file->getReverseOffsets(), this->numberOfVertices + 1);
+        this->sourcesView = ArrayView<uint32_t>(file->getSources(), numberOfArcs);
+        this->reverseWeightsView = ArrayView<float>(file->getReverseWeights(), numberOfArcs);
+    }
+    else
+    {
+        this->reverseOffsetsView = this->offsetsView;
+        this->sourcesView = this->targetsView;
+        this->reverseWeightsView = this->weightsView;
+    }
+    this->file = std::move(file);
+}
+
+void CSRGraph::viewArrays()
+{
+    this->offsetsView = this->offsets;
+    this->targetsView = this->targets;
+    this->weightsView = this->weights;
+    this->reverseOffsetsView = this->directed ? this->reverseOffsets : this->offsets;
+    this->sourcesView = this->directed ? this->sources : this->targets;
+    this->reverseWeightsView = this->directed ? this->reverseWeights : this->weights;
+}
+
+void CSRGraph::buildReverse()
+{
+    if (!this->directed)
+    {
+        return;
+    }
+
+    // Counting sort of the arcs by target. Sources are visited in ascending order, so every reverse row is sorted by source.
+    this->reverseOffsets = vector<uint32_t>(this->numberOfVertices + 1, 0);
+    for (uint32_t target : this->targets)
+    {
+        this->reverseOffsets[target + 1]++;
+    }
+    for (int v = 0; v < this->numberOfVertices; v++)
+    {
+        this->reverseOffsets[v + 1] += this->reverseOffsets[v];
+    }
+
+    vector<uint32_t> position(this->reverseOffsets.begin(), this->reverseOffsets.end() - 1);
+    this->sources = vector<uint32_t>(this->targets.size());
+    this->reverseWeights = vector<float>(this->targets.size());
+    for (int u = 0; u < this->numberOfVertices; u++)
+    {
+        for (uint32_t arc = this->offsets[u]; arc < this->offsets[u + 1]; arc++)
+        {
+            uint32_t slot = position[this->targets[arc]]++;
+            this->sources[slot] = u;
+            this->reverseWeights[slot] = this->weights[arc];
+        }
+    }
+}
+
+int CSRGraph::getNumberOfVertices() const
+{
+    return this->numberOfVertices;
+}
+
+int CSRGraph::getNumberOfArcs() const
+{
+    return this->targetsView.size();
+}
+
+bool CSRGraph::isDirected() const
+{
+    return this->directed;
+}
+
+int CSRGraph::outDegree(int vertex) const
+{
+    return this->offsetsView[vertex + 1] - this->offsetsView[vertex];
+}
+
+int CSRGraph::inDegree(int vertex) const
+{
+    return this->reverseOffsetsView[vertex + 1] - this->reverseOffsetsView[vertex];
+}
+
+ArrayView<uint32_t> CSRGraph::getOffsets() const
+{
+    return this->offsetsView;
+}
+
+ArrayView<uint32_t> CSRGraph::getTargets() const
+{
+    return this->targetsView;
+}
+
+ArrayView<float> CSRGraph::getWeights() const
+{
+    return this->weightsView;
+}
+
+ArrayView<uint32_t> CSRGraph::getReverseOffsets() const
+{
+    return this->reverseOffsetsView;
+}
+
+ArrayView<uint32_t> CSRGraph::getSources() const
+{
+    return this->sourcesView;
+}
+
+ArrayView<float> CSRGraph::getReverseWeights() const
+{
+    return this->reverseWeightsView;
+}
+
+uint64_t CSRGraph::getFingerprint() const
+{
+    // FNV-1a over 32-bit words, with the bits of every weight as stored.
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint32_t word)
+    {
+        hash = (hash ^ word) * 1099511628211ULL;
+    };
+    mix(this->numberOfVertices);
+    mix(this->directed ? 1 : 0);
+    for (uint32_t offset : this->offsetsView)
+    {
+        mix(offset);
+    }
+    for (uint32_t target : this->targetsView)
+    {
+        mix(target);
+    }
+    for (float weight : this->weightsView)
+    {
+        uint32_t bits;
+        memcpy(&bits, &weight, sizeof(bits));
+        mix(bits);
+    }
+    return hash;
+}
+
+CSRGraph::~CSRGraph()
+= default;
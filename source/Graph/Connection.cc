@@ -1,58 +1,71 @@
 #include <iostream>
-#include <utility>
 #include <vector>
 #include <tuple>
-#include "Graph/Connection.h"
-#include <tuple>
 #include <memory>
+#include <utility>
 
+#include "Graph/Connection.h"
 #include "Graph/Node.h"
+#include "Graph/GraphStorage.h"
 
 using namespace std;
 using namespace GraphModule;
 
-Connection::Connection(float weight, weak_ptr<Node> startNode, weak_ptr<Node> endNode, bool goesBothWays)
+Connection::Connection()
+{
+    this->storage = nullptr;
+    this->id = GraphStorage::NONE;
+}
+
+Connection::Connection(shared_ptr<GraphStorage> storage, uint32_t id)
+{
+    this->storage = std::move(storage);
+    this->id = id;
+}
+
+bool Connection::isValid()
+{
+    return this->storage != nullptr;
+}
+
+uint32_t Connection::getId()
 {
-    this->weight = weight;
-    this->startNode = std::move(startNode);
-    this->endNode = std::move(endNode);
-    this->goesBothWays = goesBothWays;
+    return this->id;
 }
 
 float Connection::getWeight()
 {
-    return this->weight;
+    return this->storage->getWeight(this->id);
 }
 
 shared_ptr<Node> Connection::getStartNode()
 {
-    return (this->startNode).lock();
+    return this->storage->getNode(this->storage->getStartNode(this->id));
 }
 
 shared_ptr<Node> Connection::getEndNode()
 {
-    return (this->endNode).lock();
+    return this->storage->getNode(this->storage->getEndNode(this->id));
 }
 
 bool Connection::getGoesBothWays()
 {
-    return this->goesBothWays;
+    return this->storage->getGoesBothWays(this->id);
 }
 
 void Connection::setWeight(float weight)
 {
-    this->weight = weight;
+    this->storage->setWeight(this->id, weight);
 }
 
 void Connection::setGoesBothWays(bool goesBothWays)
 {
-    this->goesBothWays = goesBothWays;
+    this->storage->setGoesBothWays(this->id, goesBothWays);
 }
 
-//Be careful for bugs. This function is not tested.
 tuple<shared_ptr<Node>, shared_ptr<Node>> Connection::getNodes()
 {
-    return make_tuple((this->startNode).lock(), (this->endNode).lock());
+    return make_tuple(this->getStartNode(), this->getEndNode());
 }
 
 Connection::~Connection()
@@ -0,0 +1,688 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <functional>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Graph/ContractionHierarchy.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/MappedFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    const char MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'C', 'H', '\0'};
+
+    // A witness search gives up after settling this many vertices and the shortcut is added anyway.
+    const int MAXIMUM_WITNESS_SETTLED = 500;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t numberOfVertices;
+        uint32_t numberOfUpwardArcs;
+        uint32_t numberOfDownwardArcs;
+        uint32_t numberOfShortcuts;
+        uint32_t numberOfGraphArcs; // Arcs and fingerprint of the snapshot the hierarchy was computed for
+        uint64_t graphFingerprint;
+        uint64_t ranksPosition;
+        uint64_t upwardOffsetsPosition;
+        uint64_t upwardArcsPosition;
+        uint64_t downwardOffsetsPosition;
+        uint64_t downwardArcsPosition;
+    };
+
+    struct Edge
+    {
+        uint32_t vertex;
+        int32_t weight;
+        int32_t middle;
+    };
+
+    struct Shortcut
+    {
+        uint32_t from;
+        uint32_t to;
+        int32_t weight;
+    };
+
+    // Graph being contracted. A vertex is removed from the lists of its neighbours when it is contracted, so the lists of
+    // an uncontracted vertex only reach uncontracted vertices and those of a contracted one are its final arcs.
+    struct Overlay
+    {
+        vector<vector<Edge>> outgoing;
+        vector<vector<Edge>> incoming;
+        vector<int> contractedNeighbours;
+    };
+
+    // Local Dijkstra that looks for paths avoiding the vertex being contracted. Every thread owns one.
+    class WitnessSearch
+    {
+        public:
+            explicit WitnessSearch(int numberOfVertices)
+                : heap(numberOfVertices), distances(numberOfVertices), stamps(numberOfVertices, 0), stamp(0)
+            {
+            }
+
+            // Shortcuts needed to contract vertex: one for every pair of neighbours without a witness path as short as the one through it.
+            // Witness paths avoid the vertices marked as leaving, which are contracted in the same round.
+            void findShortcuts(const Overlay& overlay, const vector<char>& leaving, int vertex, vector<Shortcut>& shortcuts)
+            {
+                shortcuts.clear();
+                const vector<Edge>& outgoing = overlay.outgoing[vertex];
+                for (const Edge& in : overlay.incoming[vertex])
+                {
+                    int limit = -1;
+                    for (const Edge& out : outgoing)
+                    {
+                        if (out.vertex != in.vertex)
+                        {
+                            limit = max(limit, in.weight + out.weight);
+                        }
+                    }
+                    if (limit < 0)
+                    {
+                        continue;
+                    }
+
+                    this->run(overlay, leaving, in.vertex, vertex, limit);
+                    for (const Edge& out : outgoing)
+                    {
+                        if (out.vertex != in.vertex && this->distance(out.vertex) > in.weight + out.weight)
+                        {
+                            shortcuts.push_back({in.vertex, out.vertex, in.weight + out.weight});
+                        }
+                    }
+                }
+            }
+
+        private:
+            void run(const Overlay& overlay, const vector<char>& leaving, int source, int excluded, int limit)
+            {
+                this->stamp++;
+                if (this->stamp == 0)
+                {
+                    fill(this->stamps.begin(), this->stamps.end(), 0);
+                    this->stamp = 1;
+                }
+                this->heap.clear();
+                this->stamps[source] = this->stamp;
+                this->distances[source] = 0;
+                this->heap.push(source, 0);
+
+                int settled = 0;
+                while (!this->heap.empty() && this->heap.topPriority() <= limit && settled < MAXIMUM_WITNESS_SETTLED)
+                {
+                    int u = this->heap.pop();
+                    settled++;
+                    for (const Edge& edge : overlay.outgoing[u])
+                    {
+                        int v = edge.vertex;
+                        if (v == excluded || leaving[v])
+                        {
+                            continue;
+                        }
+                        int distanceOfV = this->distances[u] + edge.weight;
+                        if (this->stamps[v] != this->stamp || distanceOfV < this->distances[v])
+                        {
+                            this->stamps[v] = this->stamp;
+                            this->distances[v] = distanceOfV;
+                            this->heap.pushOrDecrease(v, distanceOfV);
+                        }
+                    }
+                }
+            }
+
+            int distance(int vertex) const
+            {
+                return this->stamps[vertex] == this->stamp ? this->distances[vertex] : INT_MAX;
+            }
+
+            IndexedHeap<int> heap;
+            vector<int> distances;
+            vector<uint32_t> stamps;
+            uint32_t stamp;
+    };
+
+    // Runs work(thread, item) for items 0..count - 1, split in contiguous blocks over the threads.
+    void forEachInParallel(int numberOfThreads, int count, const function<void(int, int)>& work)
+    {
+        vector<thread> threads;
+        int blockSize = (count + numberOfThreads - 1) / numberOfThreads;
+        for (int t = 0; t < numberOfThreads && t * blockSize < count; t++)
+        {
+            threads.emplace_back([&work, t, blockSize, count]()
+            {
+                for (int item = t * blockSize; item < min(count, (t + 1) * blockSize); item++)
+                {
+                    work(t, item);
+                }
+            });
+        }
+        for (thread& worker : threads)
+        {
+            worker.join();
+        }
+    }
+
+    void removeEdge(vector<Edge>& edges, uint32_t vertex)
+    {
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (edges[i].vertex == vertex)
+            {
+                edges[i] = edges.back();
+                edges.pop_back();
+                return;
+            }
+        }
+    }
+
+    void addShortcut(Overlay& overlay, const Shortcut& shortcut, int middle)
+    {
+        for (Edge& edge : overlay.outgoing[shortcut.from])
+        {
+            if (edge.vertex == shortcut.to)
+            {
+                if (shortcut.weight < edge.weight)
+                {
+                    edge = {shortcut.to, shortcut.weight, middle};
+                    for (Edge& twin : overlay.incoming[shortcut.to])
+                    {
+                        if (twin.vertex == shortcut.from)
+                        {
+                            twin = {shortcut.from, shortcut.weight, middle};
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        overlay.outgoing[shortcut.from].push_back({shortcut.to, shortcut.weight, middle});
+        overlay.incoming[shortcut.to].push_back({shortcut.from, shortcut.weight, middle});
+    }
+
+    template <typename T>
+    vector<T> readSection(const MappedFile& file, uint64_t position, uint64_t count)
+    {
+        if (position % alignof(T) != 0 || position > file.size() || count > (file.size() - position) / sizeof(T))
+        {
+            throw invalid_argument(file.getPath() + " is truncated");
+        }
+        vector<T> section(count);
+        memcpy(section.data(), file.data() + position, count * sizeof(T));
+        return section;
+    }
+
+    uint64_t writeSection(ofstream& output, uint64_t& position, const void* data, uint64_t size)
+    {
+        static const char padding[8] = {};
+        uint64_t start = (position + 7) & ~uint64_t(7);
+        output.write(padding, start - position);
+        output.write(static_cast<const char*>(data), size);
+        position = start + size;
+        return start;
+    }
+}
+
+ContractionHierarchy::ContractionHierarchy(const CSRGraph& snapshot)
+{
+    this->numberOfVertices = snapshot.getNumberOfVertices();
+    this->numberOfGraphArcs = snapshot.getNumberOfArcs();
+    this->graphFingerprint = snapshot.getFingerprint();
+    this->contract(snapshot);
+    this->prepareQueries();
+}
+
+ContractionHierarchy::ContractionHierarchy(const string& filePath)
+{
+    MappedFile file(filePath);
+    Header header = {};
+    if (file.size() < sizeof(Header) || memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw invalid_argument(filePath + " is not a contraction hierarchy file");
+    }
+    memcpy(&header, file.data(), sizeof(Header));
+    if (header.version != VERSION)
+    {
+        throw invalid_argument(filePath + " has contraction hierarchy version " + to_string(header.version) + ", expected " + to_string(VERSION));
+    }
+
+    this->numberOfVertices = header.numberOfVertices;
+    this->numberOfShortcuts = header.numberOfShortcuts;
+    this->numberOfGraphArcs = header.numberOfGraphArcs;
+    this->graphFingerprint = header.graphFingerprint;
+    this->ranks = readSection<uint32_t>(file, header.ranksPosition, header.numberOfVertices);
+    this->upwardOffsets = readSection<uint32_t>(file, header.upwardOffsetsPosition, header.numberOfVertices + 1);
+    this->upwardArcs = readSection<Arc>(file, header.upwardArcsPosition, header.numberOfUpwardArcs);
+    this->downwardOffsets = readSection<uint32_t>(file, header.downwardOffsetsPosition, header.numberOfVertices + 1);
+    this->downwardArcs = readSection<Arc>(file, header.downwardArcsPosition, header.numberOfDownwardArcs);
+
+    for (uint32_t v = 0; v < header.numberOfVertices; v++)
+    {
+        if (this->ranks[v] >= header.numberOfVertices || this->upwardOffsets[v] > this->upwardOffsets[v + 1] || this->downwardOffsets[v] > this->downwardOffsets[v + 1])
+        {
+            throw invalid_argument(filePath + " has inconsistent rows");
+        }
+    }
+    if (this->upwardOffsets[0] != 0 || this->upwardOffsets.back() != header.numberOfUpwardArcs
+        || this->downwardOffsets[0] != 0 || this->downwardOffsets.back() != header.numberOfDownwardArcs)
+    {
+        throw invalid_argument(filePath + " has inconsistent rows");
+    }
+    for (const vector<Arc>* arcs : {&this->upwardArcs, &this->downwardArcs})
+    {
+        for (const Arc& arc : *arcs)
+        {
+            if (arc.vertex >= header.numberOfVertices || arc.weight < 0 || arc.middle < -1 || arc.middle >= int(header.numberOfVertices))
+            {
+                throw invalid_argument(filePath + " has an arc to an unknown vertex");
+            }
+        }
+    }
+
+    this->prepareQueries();
+}
+
+void ContractionHierarchy::contract(const CSRGraph& snapshot)
+{
+    int n = this->numberOfVertices;
+    ArrayView<uint32_t> offsets = snapshot.getOffsets();
+    ArrayView<uint32_t> targets = snapshot.getTargets();
+    ArrayView<float> weights = snapshot.getWeights();
+
+    // Parallel arcs collapse into the lightest one and loops are dropped, they never lie on a shortest path.
+    Overlay overlay;
+    overlay.outgoing = vector<vector<Edge>>(n);
+    overlay.incoming = vector<vector<Edge>>(n);
+    overlay.contractedNeighbours = vector<int>(n, 0);
+    vector<int> slots(n, -1);
+    for (int u = 0; u < n; u++)
+    {
+        vector<Edge>& outgoing = overlay.outgoing[u];
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            int v = targets[arc];
+            int w = weights[arc];
+            if (w < 0)
+            {
+                throw invalid_argument("Contraction hierarchies need non-negative weights");
+            }
+            if (v == u)
+            {
+                continue;
+            }
+            if (slots[v] == -1)
+            {
+                slots[v] = outgoing.size();
+                outgoing.push_back({uint32_t(v), w, -1});
+            }
+            else
+            {
+                outgoing[slots[v]].weight = min(outgoing[slots[v]].weight, w);
+            }
+        }
+        for (const Edge& edge : outgoing)
+        {
+            slots[edge.vertex] = -1;
+            overlay.incoming[edge.vertex].push_back({uint32_t(u), edge.weight, -1});
+        }
+    }
+
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    vector<WitnessSearch> searches(numberOfThreads, WitnessSearch(n));
+    vector<vector<Shortcut>> scratch(numberOfThreads);
+
+    // Edge difference plus the number of contracted neighbours, which spreads the contraction evenly over the graph.
+    vector<int> priorities(n);
+    vector<char> leaving(n, 0);
+    auto updatePriorities = [&](const vector<int>& vertices)
+    {
+        forEachInParallel(numberOfThreads, vertices.size(), [&](int t, int item)
+        {
+            int v = vertices[item];
+            searches[t].findShortcuts(overlay, leaving, v, scratch[t]);
+            priorities[v] = int(scratch[t].size()) - int(overlay.outgoing[v].size() + overlay.incoming[v].size()) + overlay.contractedNeighbours[v];
+        });
+    };
+    auto before = [&priorities](int first, int second)
+    {
+        return priorities[first] < priorities[second] || (priorities[first] == priorities[second] && first < second);
+    };
+
+    vector<int> remaining(n);
+    for (int v = 0; v < n; v++)
+    {
+        remaining[v] = v;
+    }
+    updatePriorities(remaining);
+
+    this->ranks = vector<uint32_t>(n);
+    this->numberOfShortcuts = 0;
+    uint32_t nextRank = 0;
+    vector<char> contracted(n, 0);
+    vector<char> changed(n, 0);
+    while (!remaining.empty())
+    {
+        // Each round contracts the vertices that come before all their neighbours. No two of them are adjacent, so their
+        // witness searches can run at the same time on the same overlay. A witness may not cross another vertex of the
+        // round, or two vertices could each count on a path through the other and both skip their shortcut.
+        vector<int> selected;
+        for (int v : remaining)
+        {
+            bool minimal = true;
+            for (const vector<Edge>* edges : {&overlay.outgoing[v], &overlay.incoming[v]})
+            {
+                for (const Edge& edge : *edges)
+                {
+                    minimal = minimal && before(v, edge.vertex);
+                }
+            }
+            if (minimal)
+            {
+                selected.push_back(v);
+                leaving[v] = 1;
+            }
+        }
+
+        vector<vector<Shortcut>> shortcuts(selected.size());
+        forEachInParallel(numberOfThreads, selected.size(), [&](int t, int item)
+        {
+            searches[t].findShortcuts(overlay, leaving, selected[item], shortcuts[item]);
+        });
+
+        for (size_t i = 0; i < selected.size(); i++)
+        {
+            int v = selected[i];
+            this->ranks[v] = nextRank++;
+            contracted[v] = 1;
+            leaving[v] = 0;
+            for (const Shortcut& shortcut : shortcuts[i])
+            {
+                addShortcut(overlay, shortcut, v);
+            }
+            this->numberOfShortcuts += shortcuts[i].size();
+
+            for (const Edge& edge : overlay.outgoing[v])
+            {
+                removeEdge(overlay.incoming[edge.vertex], v);
+                overlay.contractedNeighbours[edge.vertex]++;
+                changed[edge.vertex] = 1;
+            }
+            for (const Edge& edge : overlay.incoming[v])
+            {
+                removeEdge(overlay.outgoing[edge.vertex], v);
+                overlay.contractedNeighbours[edge.vertex]++;
+                changed[edge.vertex] = 1;
+            }
+        }
+
+        vector<int> stale;
+        size_t kept = 0;
+        for (int v : remaining)
+        {
+            if (contracted[v])
+            {
+                continue;
+            }
+            remaining[kept++] = v;
+            if (changed[v])
+            {
+                changed[v] = 0;
+                stale.push_back(v);
+            }
+        }
+        remaining.resize(kept);
+        updatePriorities(stale);
+    }
+
+    // Each contracted vertex kept exactly the arcs between it and the vertices contracted after it.
+    this->upwardOffsets = vector<uint32_t>(n + 1, 0);
+    this->downwardOffsets = vector<uint32_t>(n + 1, 0);
+    for (int v = 0; v < n; v++)
+    {
+        for (const Edge& edge : overlay.outgoing[v])
+        {
+            this->upwardArcs.push_back({edge.vertex, edge.weight, edge.middle});
+        }
+        for (const Edge& edge : overlay.incoming[v])
+        {
+            this->downwardArcs.push_back({edge.vertex, edge.weight, edge.middle});
+        }
+        this->upwardOffsets[v + 1] = this->upwardArcs.size();
+        this->downwardOffsets[v + 1] = this->downwardArcs.size();
+    }
+}
+
+void ContractionHierarchy::prepareQueries()
+{
+    this->heaps.clear();
+    for (int side = 0; side < 2; side++)
+    {
+        this->heaps.emplace_back(this->numberOfVertices);
+        this->distances[side] = vector<int>(this->numberOfVertices);
+        this->parents[side] = vector<int>(this->numberOfVertices);
+        this->parentMiddles[side] = vector<int>(this->numberOfVertices);
+        this->reachedStamps[side] = vector<uint32_t>(this->numberOfVertices, 0);
+    }
+    this->query = 0;
+    this->numberOfSettledVertices = 0;
+}
+
+void ContractionHierarchy::save(const string& filePath) const
+{
+    ofstream output(filePath, ios::out | ios::binary | ios::trunc);
+    if (!output.is_open())
+    {
+        throw runtime_error("Could not open " + filePath);
+    }
+
+    Header header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numberOfVertices = this->numberOfVertices;
+    header.numberOfUpwardArcs = this->upwardArcs.size();
+    header.numberOfDownwardArcs = this->downwardArcs.size();
+    header.numberOfShortcuts = this->numberOfShortcuts;
+    header.numberOfGraphArcs = this->numberOfGraphArcs;
+    header.graphFingerprint = this->graphFingerprint;
+
+    // Same layout as GraphFile: a placeholder header, the aligned sections, then the header again with their positions.
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    uint64_t position = sizeof(Header);
+    header.ranksPosition = writeSection(output, position, this->ranks.data(), this->ranks.size() * sizeof(uint32_t));
+    header.upwardOffsetsPosition = writeSection(output, position, this->upwardOffsets.data(), this->upwardOffsets.size() * sizeof(uint32_t));
+    header.upwardArcsPosition = writeSection(output, position, this->upwardArcs.data(), this->upwardArcs.size() * sizeof(Arc));
+    header.downwardOffsetsPosition = writeSection(output, position, this->downwardOffsets.data(), this->downwardOffsets.size() * sizeof(uint32_t));
+    header.downwardArcsPosition = writeSection(output, position, this->downwardArcs.data(), this->downwardArcs.size() * sizeof(Arc));
+
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (!output)
+    {
+        throw runtime_error("Could not write " + filePath);
+    }
+}
+
+tuple<int, vector<int>> ContractionHierarchy::shortestPath(int startNodeIndex, int endNodeIndex)
+{
+    const int FORWARD = 0;
+    const int BACKWARD = 1;
+
+    this->query++;
+    if (this->query == 0)
+    { // The stamps wrapped around, stale stamps could now match
+        fill(this->reachedStamps[FORWARD].begin(), this->reachedStamps[FORWARD].end(), 0);
+        fill(this->reachedStamps[BACKWARD].begin(), this->reachedStamps[BACKWARD].end(), 0);
+        this->query = 1;
+    }
+    this->heaps[FORWARD].clear();
+    this->heaps[BACKWARD].clear();
+    this->numberOfSettledVertices = 0;
+
+    // The forward search climbs the upward arcs from the start, the backward one climbs the downward arcs from the end.
+    const vector<uint32_t>* offsets[2] = {&this->upwardOffsets, &this->downwardOffsets};
+    const vector<Arc>* arcs[2] = {&this->upwardArcs, &this->downwardArcs};
+
+    int best = INT_MAX; // Unbounded until the searches meet, so paths longer than the infinity of dijkstra are found
+    int meeting = -1;
+    int ends[2] = {startNodeIndex, endNodeIndex};
+    for (int side : {FORWARD, BACKWARD})
+    {
+        this->reachedStamps[side][ends[side]] = this->query;
+        this->distances[side][ends[side]] = 0;
+        this->parents[side][ends[side]] = -1;
+        this->heaps[side].push(ends[side], 0);
+    }
+    if (startNodeIndex == endNodeIndex)
+    {
+        best = 0;
+        meeting = startNodeIndex;
+    }
+
+    // Both searches go on until their frontier passes the best path, since the top of a shortest path is settled by both.
+    while (true)
+    {
+        int side = -1;
+        for (int candidate : {FORWARD, BACKWARD})
+        {
+            if (!this->heaps[candidate].empty() && this->heaps[candidate].topPriority() < best
+                && (side == -1 || this->heaps[candidate].topPriority() < this->heaps[side].topPriority()))
+            {
+                side = candidate;
+            }
+        }
+        if (side == -1)
+        {
+            break;
+        }
+
+        int other = 1 - side;
+        int u = this->heaps[side].pop();
+        this->numberOfSettledVertices++;
+
+        int distanceOfU = this->distances[side][u];
+        for (uint32_t index = (*offsets[side])[u]; index < (*offsets[side])[u + 1]; index++)
+        {
+            const Arc& arc = (*arcs[side])[index];
+            int v = arc.vertex;
+            int distanceOfV = distanceOfU + arc.weight;
+            if (this->reachedStamps[side][v] != this->query || distanceOfV < this->distances[side][v])
+            {
+                this->reachedStamps[side][v] = this->query;
+                this->distances[side][v] = distanceOfV;
+                this->parents[side][v] = u;
+                this->parentMiddles[side][v] = arc.middle;
+                this->heaps[side].pushOrDecrease(v, distanceOfV);
+
+                if (this->reachedStamps[other][v] == this->query && distanceOfV + this->distances[other][v] < best)
+                {
+                    best = distanceOfV + this->distances[other][v];
+                    meeting = v;
+                }
+            }
+        }
+    }
+
+    vector<int> path;
+    if (meeting == -1)
+    {
+        return make_tuple(1000000, path); // Unreachable, reported as A* does
+    }
+
+    // Arcs of the hierarchy from the start up to the meeting vertex and from there down to the end, then unpacked.
+    vector<int> upward;
+    for (int v = meeting; v != -1; v = this->parents[FORWARD][v])
+    {
+        upward.push_back(v);
+    }
+    reverse(upward.begin(), upward.end());
+    path.push_back(startNodeIndex);
+    for (size_t i = 1; i < upward.size(); i++)
+    {
+        this->unpack(upward[i - 1], upward[i], this->parentMiddles[FORWARD][upward[i]], path);
+    }
+    for (int v = meeting; this->parents[BACKWARD][v] != -1; v = this->parents[BACKWARD][v])
+    {
+        this->unpack(v, this->parents[BACKWARD][v], this->parentMiddles[BACKWARD][v], path);
+    }
+
+    return make_tuple(best, path);
+}
+
+const ContractionHierarchy::Arc& ContractionHierarchy::findArc(int from, int to) const
+{
+    // An arc is stored at its endpoint of lower rank, and only the lightest arc between two vertices is kept.
+    bool upward = this->ranks[from] < this->ranks[to];
+    int owner = upward ? from : to;
+    int other = upward ? to : from;
+    const vector<uint32_t>& offsets = upward ? this->upwardOffsets : this->downwardOffsets;
+    const vector<Arc>& arcs = upward ? this->upwardArcs : this->downwardArcs;
+    for (uint32_t index = offsets[owner]; index < offsets[owner + 1]; index++)
+    {
+        if (int(arcs[index].vertex) == other)
+        {
+            return arcs[index];
+        }
+    }
+    throw runtime_error("The contraction hierarchy has no arc from " + to_string(from + 1) + " to " + to_string(to + 1));
+}
+
+void ContractionHierarchy::unpack(int from, int to, int middle, vector<int>& path) const
+{
+    // Appends the vertices after from up to to. A shortcut stands for the two arcs through the vertex it bypasses, which
+    // may be shortcuts themselves, so an explicit stack keeps long chains off the call stack.
+    vector<tuple<int, int, int>> pending = {make_tuple(from, to, middle)};
+    while (!pending.empty())
+    {
+        auto [tail, head, bypassed] = pending.back();
+        pending.pop_back();
+        if (bypassed == -1)
+        {
+            path.push_back(head);
+            continue;
+        }
+        pending.emplace_back(bypassed, head, this->findArc(bypassed, head).middle);
+        pending.emplace_back(tail, bypassed, this->findArc(tail, bypassed).middle);
+    }
+}
+
+int ContractionHierarchy::getNumberOfVertices() const
+{
+    return this->numberOfVertices;
+}
+
+bool ContractionHierarchy::belongsTo(const CSRGraph& snapshot) const
+{
+    return this->numberOfVertices == snapshot.getNumberOfVertices() && this->numberOfGraphArcs == snapshot.getNumberOfArcs()
+           && this->graphFingerprint == snapshot.getFingerprint();
+}
+
+int ContractionHierarchy::getNumberOfShortcuts() const
+{
+    return this->numberOfShortcuts;
+}
+
+int ContractionHierarchy::getNumberOfSettledVertices() const
+{
+    return this->numberOfSettledVertices;
+}
+
+const vector<uint32_t>& ContractionHierarchy::getRanks() const
+{
+    return this->ranks;
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+= default;
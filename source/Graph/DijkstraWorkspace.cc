@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph/DijkstraWorkspace.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+DijkstraWorkspace::DijkstraWorkspace(shared_ptr<const CSRGraph> snapshot)
+    : heap(snapshot->getNumberOfVertices())
+{
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    this->distances = vector<int>(numberOfVertices);
+    this->parents = vector<int>(numberOfVertices);
+    this->reachedStamps = vector<uint32_t>(numberOfVertices, 0);
+    this->settledStamps = vector<uint32_t>(numberOfVertices, 0);
+    this->settled.reserve(numberOfVertices);
+    this->snapshot = std::move(snapshot);
+    this->query = 0;
+}
+
+void DijkstraWorkspace::run(int startNodeIndex)
+{
+    if (startNodeIndex < 0 || startNodeIndex >= this->snapshot->getNumberOfVertices())
+    {
+        throw invalid_argument("Invalid start vertex " + to_string(startNodeIndex));
+    }
+
+    this->query++;
+    if (this->query == 0)
+    { // The stamps wrapped around, stale stamps could now match
+        fill(this->reachedStamps.begin(), this->reachedStamps.end(), 0);
+        fill(this->settledStamps.begin(), this->settledStamps.end(), 0);
+        this->query = 1;
+    }
+    this->heap.clear();
+    this->settled.clear();
+
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    ArrayView<uint32_t> targets = this->snapshot->getTargets();
+    ArrayView<float> weights = this->snapshot->getWeights();
+
+    this->reachedStamps[startNodeIndex] = this->query;
+    this->distances[startNodeIndex] = 0;
+    this->parents[startNodeIndex] = -1;
+    this->heap.push(startNodeIndex, 0);
+
+    while (!this->heap.empty())
+    {
+        int u = this->heap.pop();
+        this->settledStamps[u] = this->query;
+        this->settled.push_back(u);
+        int distanceOfU = this->distances[u];
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            int v = targets[arc];
+            if (this->settledStamps[v] == this->query)
+            {
+                continue;
+            }
+            int w = weights[arc];
+            int distanceOfV = distanceOfU + w;
+            if (distanceOfV < (this->isReached(v) ? this->distances[v] : INFINITE_DISTANCE))
+            {
+                this->reachedStamps[v] = this->query;
+                this->distances[v] = distanceOfV;
+                this->parents[v] = u;
+                this->heap.pushOrDecrease(v, distanceOfV);
+            }
+        }
+    }
+}
+
+bool DijkstraWorkspace::isReached(int vertex) const
+{
+    return this->reachedStamps[vertex] == this->query;
+}
+
+int DijkstraWorkspace::getDistance(int vertex) const
+{
+    return this->isReached(vertex) ? this->distances[vertex] : INFINITE_DISTANCE;
+}
+
+int DijkstraWorkspace::getParent(int vertex) const
+{
+    return this->isReached(vertex) ? this->parents[vertex] : -1;
+}
+
+const vector<int>& DijkstraWorkspace::getSettled() const
+{
+    return this->settled;
+}
+
+void DijkstraWorkspace::copyTo(int* distances, int* parents) const
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    fill(distances, distances + numberOfVertices, INFINITE_DISTANCE);
+    fill(parents, parents + numberOfVertices, -1);
+    for (int v : this->settled)
+    {
+        distances[v] = this->distances[v];
+        parents[v] = this->parents[v];
+    }
+}
+
+const shared_ptr<const CSRGraph>& DijkstraWorkspace::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+DijkstraWorkspace::~DijkstraWorkspace()
+= default;
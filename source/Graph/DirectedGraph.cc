@@ -5,14 +5,19 @@
 #include <fstream>
 #include <sstream>
 #include <queue>
-#include <stack>
 #include <list>
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <stdexcept>
 
 #include "Graph/DirectedGraph.h"
 #include "Graph/Node.h"
 #include "Graph/Connection.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/GraphFile.h"
+#include "Graph/ContractionHierarchy.h"
 
 using namespace std;
 using namespace GraphModule;
@@ -24,130 +29,82 @@ DirectedGraph::DirectedGraph()
 
 int DirectedGraph::getDegreeOfNode(int nodeKey)
 {
-    shared_ptr<Node> node = this->nodes[nodeKey];
+    return this->storage->inDegree(nodeKey) + this->storage->outDegree(nodeKey);
+}
 
-    return (node->getIncomingConnections()).size() + (node->getOutgoingConnections()).size();
+bool DirectedGraph::isDirected()
+{
+    return true;
 }
 
 int DirectedGraph::getInDegreeOfNode(int nodeKey)
 {
-    shared_ptr<Node> node = this->nodes[nodeKey];
-
-    return (node->getIncomingConnections()).size();
+    return this->storage->inDegree(nodeKey);
 }
 
 int DirectedGraph::getOutDegreeOfNode(int nodeKey)
 {
-    shared_ptr<Node> node = this->nodes[nodeKey];
-
-    return (node->getOutgoingConnections()).size();
+    return this->storage->outDegree(nodeKey);
 }
 
-void DirectedGraph::DFSVisit(int v, bool C[])
+vector<int> DirectedGraph::degreeSequence()
 {
-    C[v] = true;
-    cout << v+1; // Prints current v node
- 
-    list<int>::iterator i;
-    for (i = adj[v].begin(); i != adj[v].end(); ++i)
-    { // iters for the connections
-        if (!C[*i])
-        {
-            cout<<",";
-            DFSVisit(*i, C);
-        }
-    }
-}
- 
-unique_ptr<DirectedGraph> DirectedGraph::BuildTransposedGraph()
-{    
-    int V = this->numberOfVertices;
-    auto transp_graph = new DirectedGraph();
-    transp_graph->adj = new list<int>[V]; 
-
-    for (int v = 0; v < V; v++)
+    const vector<uint32_t>& inDegrees = this->storage->getInDegrees();
+    const vector<uint32_t>& outDegrees = this->storage->getOutDegrees();
+    vector<int> degrees(inDegrees.size());
+    for (size_t v = 0; v < degrees.size(); v++)
     {
-        list<int>::iterator i;
-        for(i = adj[v].begin(); i != adj[v].end(); ++i)
-        { // Inverts connections of arcs
-            transp_graph->adj[*i].push_back(v);
-        }
+        degrees[v] = inDegrees[v] + outDegrees[v];
     }
-    unique_ptr<DirectedGraph> graphUniquePtr(transp_graph);
-    return graphUniquePtr;
+
+    return degrees;
 }
 
-void DirectedGraph::DFS(int v, bool C[], stack<int> &Stack)
+vector<int> DirectedGraph::inDegreeSequence()
 {
-    C[v] = true;
- 
-    list<int>::iterator i;
-    for(i = adj[v].begin(); i != adj[v].end(); ++i)
-    {
-        if(!C[*i])
-        {
-            DFS(*i, C, Stack);
-        }
-    }
- 
-    Stack.push(v); // Adds to stack once all have been visited in regards to v node
+    const vector<uint32_t>& degrees = this->storage->getInDegrees();
+
+    return vector<int>(degrees.begin(), degrees.end());
 }
- 
-void DirectedGraph::stronglyConnectedComponents()
+
+vector<int> DirectedGraph::outDegreeSequence()
 {
-    int V = this->numberOfVertices;
-    adj = new list<int>[V];
-
-    for(auto conn:this->arcs)
-    { // Builds adjacency matrix
-        int i = conn->getStartNode()->getNumber() - 1;
-        int j = conn->getEndNode()->getNumber() - 1 ;
-        adj[i].push_back(j);
-    }
+    const vector<uint32_t>& degrees = this->storage->getOutDegrees();
 
-    stack<int> Stack;
+    return vector<int>(degrees.begin(), degrees.end());
+}
 
-    bool *C = new bool[V];
-    for(int i = 0; i < V; i++)
-    { // Initializes values of C to keep track of visited nodes during DFS
-        C[i] = false;
-    }
- 
-    for(int i = 0; i < V; i++)
-    { // Puts in stack according to their finishing times
-        if(C[i] == false)
-        {
-            DFS(i, C, Stack);
-        }
-    }
- 
-    unique_ptr<DirectedGraph> transposedGraph = BuildTransposedGraph();
- 
-    for(int i = 0; i < V; i++)
-    { // Reset values for the second DFS
-        C[i] = false;
-    }
- 
-    while (Stack.empty() == false)
+StronglyConnectedComponents DirectedGraph::stronglyConnectedComponents(bool withCondensation)
+{
+    return StronglyConnectedComponents(*this->getSnapshot(), withCondensation);
+}
+
+void DirectedGraph::printStronglyConnectedComponents(const StronglyConnectedComponents& components)
+{
+    // Ids close sinks first, so the last one is printed first.
+    const vector<int>& offsets = components.getComponentOffsets();
+    vector<int> vertices;
+    for (int component = components.getNumberOfComponents() - 1; component >= 0; component--)
     {
-        int v = Stack.top();
-        Stack.pop();
-        if (C[v] == false)
+        vertices.assign(components.getComponentVertices().begin() + offsets[component],
+                        components.getComponentVertices().begin() + offsets[component + 1]);
+        sort(vertices.begin(), vertices.end());
+        for (size_t i = 0; i < vertices.size(); i++)
         {
-            transposedGraph->DFSVisit(v, C);
-            cout << endl;
+            cout << (i == 0 ? "" : ",") << vertices[i] + 1;
         }
+        cout << endl;
     }
 }
 
 vector<shared_ptr<Node>> DirectedGraph::topologicalSorting()
 {
-    int numberOfVertices = this->numberOfVertices; // Number of vertices in the graph.
-    vector<shared_ptr<Node>> nodes = this->nodes; // Vector of nodes in the graph.
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    int numberOfVertices = snapshot->getNumberOfVertices(); // Number of vertices in the graph.
     vector<bool> C; // Vector of 
     vector<int> T; // Vector of 
     vector<int> F; // Vector of
-    vector<shared_ptr<Node>> O; // Vector of nodes in topological order.
+    vector<int> finished; // Vertices in the order their DFS visit ends, the reverse of the topological order.
     int time = 0; // Time variable.
 
     // Initializes values.
@@ -162,33 +119,41 @@ vector<shared_ptr<Node>> DirectedGraph::topologicalSorting()
     {
         if (!C[u])
         {   
-            this->DFSVisitTopologicalSorting(u, C, F, T, O, time);
+            this->DFSVisitTopologicalSorting(*snapshot, u, C, F, T, finished, time);
         }
     }
 
+    vector<shared_ptr<Node>> O; // Vector of nodes in topological order.
+    O.reserve(finished.size());
+    for (auto i = finished.rbegin(); i != finished.rend(); ++i)
+    {
+        O.push_back(this->storage->getNode(*i));
+    }
+
     return O;
 }
 
-void DirectedGraph::DFSVisitTopologicalSorting(int v, vector<bool> &C, vector<int> &F, vector<int> &T, vector<shared_ptr<Node>> &O, int &time)
+void DirectedGraph::DFSVisitTopologicalSorting(const CSRGraph &snapshot, int v, vector<bool> &C, vector<int> &F, vector<int> &T, vector<int> &O, int &time)
 {
+    ArrayView<uint32_t> offsets = snapshot.getOffsets();
+    ArrayView<uint32_t> targets = snapshot.getTargets();
     C[v] = true;
     time++;
     T[v] = time;
 
-    vector<shared_ptr<Node>> outgoingNeighbours = this->nodes[v]->getOutgoingNeighbours();
-    for (const auto& neighbour : outgoingNeighbours)
+    for (uint32_t arc = offsets[v]; arc < offsets[v + 1]; arc++)
     {
-        int neighbourVertice = neighbour->getNumber();
-        if (!C[neighbourVertice - 1])
+        int neighbourIndex = targets[arc];
+        if (!C[neighbourIndex])
         {
-            this->DFSVisitTopologicalSorting(neighbourVertice -1, C, F, T, O, time);
+            this->DFSVisitTopologicalSorting(snapshot, neighbourIndex, C, F, T, O, time);
         }
     }
 
     time++;
     F[v] = time;
 
-    O.insert(O.begin(), nodes[v]);
+    O.push_back(v);
 }
 
 void DirectedGraph::printTopologicalSorting(const vector<shared_ptr<Node>> &O)
@@ -208,95 +173,123 @@ void DirectedGraph::printTopologicalSorting(const vector<shared_ptr<Node>> &O)
 
 void DirectedGraph::addArc(const shared_ptr<Node> &startNode, const shared_ptr<Node> &endNode, float weight)
 {
-    weak_ptr<Node> startNodeWeakPtr(startNode);
-    weak_ptr<Node> endNodeWeakPtr(endNode);
-
-    shared_ptr<Connection> connectionSharedPtr = make_shared<Connection>(weight, startNodeWeakPtr, endNodeWeakPtr, false);
-    this->arcs.push_back(connectionSharedPtr);
-    
-    weak_ptr<Connection> connectionWeakPtr(connectionSharedPtr);
-    startNode->addOutgoingConnection(connectionWeakPtr);
-    endNode->addIncomingConnection(connectionWeakPtr);
+    this->storage->addConnection(startNode->getId(), endNode->getId(), weight, false);
 
     this->numberOfArcs++;
 }
 
+void DirectedGraph::addConnections(const uint32_t* offsets, const uint32_t* targets, const float* weights)
+{
+    uint32_t numberOfVertices = this->storage->getNumberOfNodes();
+    for (uint32_t u = 0; u < numberOfVertices; u++)
+    {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            this->storage->addConnection(u, targets[arc], weights[arc], false);
+        }
+    }
+
+    this->numberOfArcs += offsets[numberOfVertices];
+}
+
+void DirectedGraph::loadConnections(const GraphFile& file)
+{
+    this->numberOfArcs += file.getNumberOfArcs();
+}
+
 int DirectedGraph::edmondsKarp(int beginNodeIndex, int endNodeIndex)
 {
     /* Crie um programa que receba um grafo dirigido e ponderado como argumento. Ao final, imprima na tela:
     /  - [X] o valor do fluxo maximo resultante da execucao do algoritmo de Edmonds-Karp.*/
 
-    int V = this->numberOfVertices; // Number of vertices in the graph.
-    vector<vector<float>> graphAdjacency; // Adjacency matrix
-    int parent[V]; // BFS result array
-    int u, v;
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets();
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+    ArrayView<float> weights = snapshot->getWeights();
+    int V = snapshot->getNumberOfVertices(); // Number of vertices in the graph.
+    int E = snapshot->getNumberOfArcs();
+    vector<int> parentArc(V); // BFS result array, the residual arc used to reach each vertex
+    int v;
     int max_flow = 0;
 
-    for (u = 0; u < V; u++) 
-    { // Builds adjacency matrices. Initialize with wieghts, if there isn't, initialize with 0.
-        vector<float> connections;
-        for (int v = 0; v < V; v++)
-        {    
-            connections.push_back(0);
+    // Builds the residual network. Each arc u->v gets a twin v->u with capacity 0, and both are bucketed by tail with a counting sort.
+    this->residualOffsets = vector<uint32_t>(V + 1, 0);
+    for (int u = 0; u < V; u++)
+    {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            this->residualOffsets[u + 1]++;
+            this->residualOffsets[targets[arc] + 1]++;
         }
-        graphAdjacency.push_back(connections);
-    } 
-    for (u = 0; u < V; u++) 
-    { // this is so bad it makes me wanna puke
-        vector<shared_ptr<Connection>> cons = this->nodes[u]->getOutgoingConnections();
-        for (auto m : cons) 
+    }
+    for (int u = 0; u < V; u++)
+    {
+        this->residualOffsets[u + 1] += this->residualOffsets[u];
+    }
+
+    vector<uint32_t> position(this->residualOffsets.begin(), this->residualOffsets.end() - 1);
+    this->residualTargets = vector<uint32_t>(2 * E);
+    this->residualTwins = vector<uint32_t>(2 * E);
+    this->residualCapacities = vector<float>(2 * E);
+    for (int u = 0; u < V; u++)
+    {
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
         {
-            graphAdjacency[m->getStartNode()->getNumber()-1][m->getEndNode()->getNumber()-1] = m->getWeight();
+            uint32_t forward = position[u]++;
+            uint32_t backward = position[targets[arc]]++;
+            this->residualTargets[forward] = targets[arc];
+            this->residualCapacities[forward] = weights[arc];
+            this->residualTwins[forward] = backward;
+            this->residualTargets[backward] = u;
+            this->residualCapacities[backward] = 0;
+            this->residualTwins[backward] = forward;
         }
     }
-    this->residualNetwork = graphAdjacency;
     
-    while (BFS(beginNodeIndex, endNodeIndex, parent)) 
+    while (BFS(beginNodeIndex, endNodeIndex, parentArc)) 
     {
         float path_flow = 1000000;
-        for (v = endNodeIndex; v != beginNodeIndex; v = parent[v]) 
+        for (v = endNodeIndex; v != beginNodeIndex; v = this->residualTargets[this->residualTwins[parentArc[v]]]) 
         {
-            u = parent[v];
-            path_flow = min(path_flow, this->residualNetwork[u][v]);
+            path_flow = min(path_flow, this->residualCapacities[parentArc[v]]);
         }
  
-        for (v = endNodeIndex; v != beginNodeIndex; v = parent[v]) 
+        for (v = endNodeIndex; v != beginNodeIndex; v = this->residualTargets[this->residualTwins[parentArc[v]]]) 
         { // Updates and changes arcs
-            u = parent[v];
-            this->residualNetwork[u][v] -= path_flow;
-            this->residualNetwork[v][u] += path_flow;
+            this->residualCapacities[parentArc[v]] -= path_flow;
+            this->residualCapacities[this->residualTwins[parentArc[v]]] += path_flow;
         }
         max_flow += path_flow;
     }
     return max_flow;
 }
 
-int DirectedGraph::BFS(int beginNodeIndex, int endNodeIndex, int parent[])
+int DirectedGraph::BFS(int beginNodeIndex, int endNodeIndex, vector<int> &parentArc)
 {
-    int V = this->numberOfVertices;
-    bool visited[V];
+    int V = this->residualOffsets.size() - 1;
+    vector<bool> visited(V, false); //Initialize as false
     queue<int> Q;
 
-    memset(visited, 0, sizeof(visited)); //Initialize as false
     Q.push(beginNodeIndex);
     visited[beginNodeIndex] = true;
-    parent[beginNodeIndex] = -1;
+    parentArc[beginNodeIndex] = -1;
     
     while (!Q.empty()) 
     {
         int u = Q.front();
         Q.pop();
-        for (int v = 0; v < V; v++) 
+        for (uint32_t arc = this->residualOffsets[u]; arc < this->residualOffsets[u + 1]; arc++) 
         {
-            if (visited[v] == false && this->residualNetwork[u][v] > 0) 
+            int v = this->residualTargets[arc];
+            if (visited[v] == false && this->residualCapacities[arc] > 0) 
             {
                 if (v == endNodeIndex) 
                 {
-                    parent[v] = u;
+                    parentArc[v] = arc;
                     return 1;
                 }
                 Q.push(v);
-                parent[v] = u;
+                parentArc[v] = arc;
                 visited[v] = true;
             }
         }
@@ -310,5 +303,32 @@ void DirectedGraph::printEdmontsKarp(int max_flow)
     cout << "\nMax flow equals "<< max_flow <<endl;
 }
 
+const shared_ptr<ContractionHierarchy>& DirectedGraph::getContractionHierarchy()
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!this->hierarchy || this->hierarchySnapshot != snapshot)
+    {
+        this->hierarchy = make_shared<ContractionHierarchy>(*snapshot);
+        this->hierarchySnapshot = snapshot;
+    }
+    return this->hierarchy;
+}
+
+void DirectedGraph::setContractionHierarchy(shared_ptr<ContractionHierarchy> hierarchy)
+{
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    if (!hierarchy->belongsTo(*snapshot))
+    {
+        throw invalid_argument("The contraction hierarchy was computed for another graph");
+    }
+    this->hierarchy = std::move(hierarchy);
+    this->hierarchySnapshot = snapshot;
+}
+
+tuple<int, vector<int>> DirectedGraph::contractedShortestPath(int startNodeIndex, int endNodeIndex)
+{
+    return this->getContractionHierarchy()->shortestPath(startNodeIndex, endNodeIndex);
+}
+
 DirectedGraph::~DirectedGraph()
 = default;
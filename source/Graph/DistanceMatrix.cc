@@ -0,0 +1,331 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+#include "Graph/DistanceMatrix.h"
+#include "Graph/MappedFile.h"
+#include "Graph/BlockedFloydWarshall.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    const char MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'A', 'P', 'D'};
+
+    // The distances start at DATA_POSITION and the next hops right after them, both 64-byte aligned in the file as in memory.
+    const uint64_t DATA_POSITION = 64;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t type;
+        uint32_t numberOfVertices;
+        uint32_t stride;
+        uint32_t nextHopWidth;
+        uint32_t reserved;
+        uint64_t graphFingerprint; // 0 until the matrix is complete
+    };
+
+    int widthOf(DistanceType type)
+    {
+        switch (type)
+        {
+            case DistanceType::INT32:
+                return sizeof(int32_t);
+            case DistanceType::FLOAT32:
+                return sizeof(float);
+            case DistanceType::UINT16:
+                return sizeof(uint16_t);
+        }
+        throw invalid_argument("Invalid distance type " + to_string(static_cast<uint32_t>(type)));
+    }
+}
+
+DistanceMatrix::DistanceMatrix(int numberOfVertices, DistanceType type, bool withNextHops)
+    : DistanceMatrix(numberOfVertices, type, withNextHops, "")
+{
+}
+
+DistanceMatrix::DistanceMatrix(int numberOfVertices, DistanceType type, bool withNextHops, const string& filePath)
+    : heapBuffer(nullptr, free)
+{
+    if (numberOfVertices < 0)
+    {
+        throw invalid_argument("Invalid number of vertices " + to_string(numberOfVertices));
+    }
+    this->numberOfVertices = numberOfVertices;
+    this->stride = BlockedFloydWarshall<int32_t>::paddedSize(max(numberOfVertices, 1));
+    this->type = type;
+    this->distanceWidth = widthOf(type);
+    this->nextHopWidth = !withNextHops ? 0 : numberOfVertices < UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t); // All ones is NO_HOP
+    this->graphFingerprint = 0;
+    this->readOnly = false;
+    this->allocate(filePath);
+}
+
+DistanceMatrix::DistanceMatrix(const string& filePath)
+    : heapBuffer(nullptr, free)
+{
+    this->file = make_unique<MappedFile>(filePath);
+    Header header = {};
+    if (this->file->size() < DATA_POSITION || memcmp(this->file->data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw invalid_argument(filePath + " is not a distance matrix file");
+    }
+    memcpy(&header, this->file->data(), sizeof(Header));
+    if (header.version != VERSION)
+    {
+        throw invalid_argument(filePath + " has distance matrix file version " + to_string(header.version) + ", expected " + to_string(VERSION));
+    }
+
+    this->numberOfVertices = header.numberOfVertices;
+    this->stride = header.stride;
+    this->type = static_cast<DistanceType>(header.type);
+    this->distanceWidth = widthOf(this->type);
+    this->nextHopWidth = header.nextHopWidth;
+    this->graphFingerprint = header.graphFingerprint;
+    uint64_t cells = static_cast<uint64_t>(this->stride) * this->stride;
+    if (this->stride != BlockedFloydWarshall<int32_t>::paddedSize(max(this->numberOfVertices, 1))
+        || (this->nextHopWidth != 0 && this->nextHopWidth != sizeof(uint16_t) && this->nextHopWidth != sizeof(uint32_t))
+        || this->file->size() != DATA_POSITION + cells * (this->distanceWidth + this->nextHopWidth))
+    {
+        throw invalid_argument(filePath + " is truncated or corrupt");
+    }
+
+    this->readOnly = true;
+    this->distanceData = const_cast<char*>(this->file->data()) + DATA_POSITION;
+    this->nextHopData = this->nextHopWidth == 0 ? nullptr : this->distanceData + cells * this->distanceWidth;
+}
+
+DistanceMatrix::DistanceMatrix(DistanceMatrix&& other) noexcept
+= default;
+
+DistanceMatrix& DistanceMatrix::operator=(DistanceMatrix&& other) noexcept
+= default;
+
+void DistanceMatrix::allocate(const string& filePath)
+{
+    uint64_t cells = static_cast<uint64_t>(this->stride) * this->stride;
+    uint64_t size = cells * (this->distanceWidth + this->nextHopWidth);
+
+    if (filePath.empty())
+    {
+        // Every row is a whole number of cache lines, so a single aligned block holds both matrices aligned.
+        this->heapBuffer.reset(static_cast<char*>(aligned_alloc(64, size)));
+        if (!this->heapBuffer)
+        {
+            throw bad_alloc();
+        }
+        this->distanceData = this->heapBuffer.get();
+    }
+    else
+    {
+        this->file = make_unique<MappedFile>(filePath, DATA_POSITION + size);
+        Header header = {};
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.type = static_cast<uint32_t>(this->type);
+        header.numberOfVertices = this->numberOfVertices;
+        header.stride = this->stride;
+        header.nextHopWidth = this->nextHopWidth;
+        memcpy(this->file->writableData(), &header, sizeof(Header));
+        this->distanceData = this->file->writableData() + DATA_POSITION;
+    }
+    this->nextHopData = this->nextHopWidth == 0 ? nullptr : this->distanceData + cells * this->distanceWidth;
+}
+
+void DistanceMatrix::checkWritable() const
+{
+    if (this->readOnly)
+    {
+        throw logic_error("The distance matrix is mapped read-only from " + this->file->getPath());
+    }
+}
+
+void DistanceMatrix::reset()
+{
+    switch (this->type)
+    {
+        case DistanceType::INT32:
+            this->resetDistances<int32_t>();
+            break;
+        case DistanceType::FLOAT32:
+            this->resetDistances<float>();
+            break;
+        case DistanceType::UINT16:
+            this->resetDistances<uint16_t>();
+            break;
+    }
+    if (this->nextHopWidth == sizeof(uint16_t))
+    {
+        this->resetNextHops<uint16_t>();
+    }
+    else if (this->nextHopWidth == sizeof(uint32_t))
+    {
+        this->resetNextHops<uint32_t>();
+    }
+}
+
+int DistanceMatrix::getNumberOfVertices() const
+{
+    return this->numberOfVertices;
+}
+
+DistanceType DistanceMatrix::getType() const
+{
+    return this->type;
+}
+
+int DistanceMatrix::getStride() const
+{
+    return this->stride;
+}
+
+uint64_t DistanceMatrix::getGraphFingerprint() const
+{
+    return this->graphFingerprint;
+}
+
+void DistanceMatrix::setGraphFingerprint(uint64_t fingerprint)
+{
+    this->checkWritable();
+    this->graphFingerprint = fingerprint;
+    if (this->file)
+    {
+        memcpy(this->file->writableData() + offsetof(Header, graphFingerprint), &fingerprint, sizeof(fingerprint));
+    }
+}
+
+bool DistanceMatrix::hasNextHops() const
+{
+    return this->nextHopWidth != 0;
+}
+
+int DistanceMatrix::getNextHopWidth() const
+{
+    return this->nextHopWidth;
+}
+
+bool DistanceMatrix::isReachable(int from, int to) const
+{
+    size_t cell = static_cast<size_t>(from) * this->stride + to;
+    switch (this->type)
+    {
+        case DistanceType::INT32:
+            return reinterpret_cast<const int32_t*>(this->distanceData)[cell] != DistanceTraits<int32_t>::INFINITE;
+        case DistanceType::FLOAT32:
+            return reinterpret_cast<const float*>(this->distanceData)[cell] != DistanceTraits<float>::INFINITE;
+        case DistanceType::UINT16:
+            return reinterpret_cast<const uint16_t*>(this->distanceData)[cell] != DistanceTraits<uint16_t>::INFINITE;
+    }
+    return false;
+}
+
+double DistanceMatrix::getDistance(int from, int to) const
+{
+    size_t cell = static_cast<size_t>(from) * this->stride + to;
+    switch (this->type)
+    {
+        case DistanceType::INT32:
+            return reinterpret_cast<const int32_t*>(this->distanceData)[cell];
+        case DistanceType::FLOAT32:
+            return reinterpret_cast<const float*>(this->distanceData)[cell];
+        case DistanceType::UINT16:
+            return reinterpret_cast<const uint16_t*>(this->distanceData)[cell];
+    }
+    return 0;
+}
+
+void DistanceMatrix::setDistance(int from, int to, double distance)
+{
+    // Integer matrices clamp at their infinity, so anything as long or longer reads as unreachable.
+    this->checkWritable();
+    size_t cell = static_cast<size_t>(from) * this->stride + to;
+    switch (this->type)
+    {
+        case DistanceType::INT32:
+            reinterpret_cast<int32_t*>(this->distanceData)[cell] = static_cast<int32_t>(min(distance, static_cast<double>(DistanceTraits<int32_t>::INFINITE)));
+            break;
+        case DistanceType::FLOAT32:
+            reinterpret_cast<float*>(this->distanceData)[cell] = static_cast<float>(distance);
+            break;
+        case DistanceType::UINT16:
+            if (distance < 0)
+            {
+                throw invalid_argument("A uint16 distance matrix cannot hold the negative distance " + to_string(distance));
+            }
+            reinterpret_cast<uint16_t*>(this->distanceData)[cell] = static_cast<uint16_t>(min(distance, static_cast<double>(DistanceTraits<uint16_t>::INFINITE)));
+            break;
+    }
+}
+
+int DistanceMatrix::getNextHop(int from, int to) const
+{
+    size_t cell = static_cast<size_t>(from) * this->stride + to;
+    if (this->nextHopWidth == sizeof(uint16_t))
+    {
+        uint16_t hop = reinterpret_cast<const uint16_t*>(this->nextHopData)[cell];
+        return hop == UINT16_MAX ? NO_HOP : hop;
+    }
+    if (this->nextHopWidth == sizeof(uint32_t))
+    {
+        uint32_t hop = reinterpret_cast<const uint32_t*>(this->nextHopData)[cell];
+        return hop == UINT32_MAX ? NO_HOP : static_cast<int>(hop);
+    }
+    throw logic_error("The distance matrix keeps no next hops");
+}
+
+void DistanceMatrix::setNextHop(int from, int to, int hop)
+{
+    this->checkWritable();
+    size_t cell = static_cast<size_t>(from) * this->stride + to;
+    if (this->nextHopWidth == sizeof(uint16_t))
+    {
+        reinterpret_cast<uint16_t*>(this->nextHopData)[cell] = hop == NO_HOP ? UINT16_MAX : static_cast<uint16_t>(hop);
+    }
+    else if (this->nextHopWidth == sizeof(uint32_t))
+    {
+        reinterpret_cast<uint32_t*>(this->nextHopData)[cell] = hop == NO_HOP ? UINT32_MAX : static_cast<uint32_t>(hop);
+    }
+    else
+    {
+        throw logic_error("The distance matrix keeps no next hops");
+    }
+}
+
+vector<int> DistanceMatrix::path(int from, int to) const
+{
+    if (!this->isReachable(from, to))
+    {
+        return {};
+    }
+
+    // A path never repeats a vertex, so a longer walk means the hops went round a negative cycle.
+    vector<int> vertices = {from};
+    while (vertices.back() != to)
+    {
+        int hop = this->getNextHop(vertices.back(), to);
+        if (hop == NO_HOP)
+        {
+            return {};
+        }
+        if (static_cast<int>(vertices.size()) > this->numberOfVertices)
+        {
+            throw runtime_error("The next hops to vertex " + to_string(to + 1) + " go round a negative cycle");
+        }
+        vertices.push_back(hop);
+    }
+    return vertices;
+}
+
+DistanceMatrix::~DistanceMatrix()
+= default;
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "Graph/EdgeIndex.h"
+#include "Graph/GraphStorage.h"
+
+using namespace std;
+using namespace GraphModule;
+
+EdgeIndex::EdgeIndex(const GraphStorage& storage)
+{
+    uint32_t numberOfNodes = storage.getNumberOfNodes();
+    this->offsets = vector<uint32_t>(numberOfNodes + 1, 0);
+    this->endNodes.reserve(storage.getNumberOfConnections());
+    this->connections.reserve(storage.getNumberOfConnections());
+
+    vector<pair<uint32_t, uint32_t>> row;
+    for (uint32_t u = 0; u < numberOfNodes; u++)
+    {
+        row.clear();
+        for (uint32_t conn = storage.firstOutgoing(u); conn != GraphStorage::NONE; conn = storage.nextOutgoing(conn))
+        {
+            row.emplace_back(storage.getEndNode(conn), conn);
+        }
+        sort(row.begin(), row.end());
+
+        for (const auto& [endNode, conn] : row)
+        {
+            this->endNodes.push_back(endNode);
+            this->connections.push_back(conn);
+        }
+        this->offsets[u + 1] = this->endNodes.size();
+    }
+}
+
+uint32_t EdgeIndex::find(uint32_t startNode, uint32_t endNode) const
+{
+    auto rowBegin = this->endNodes.begin() + this->offsets[startNode];
+    auto rowEnd = this->endNodes.begin() + this->offsets[startNode + 1];
+    auto it = lower_bound(rowBegin, rowEnd, endNode);
+
+    if (it == rowEnd || *it != endNode)
+    {
+        return GraphStorage::NONE;
+    }
+    return this->connections[it - this->endNodes.begin()];
+}
+
+EdgeIndex::~EdgeIndex()
+= default;
@@ -0,0 +1,308 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Graph/GraphFile.h"
+#include "Graph/AbstractGraph.h"
+#include "Graph/DirectedGraph.h"
+#include "Graph/UndirectedGraph.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/Node.h"
+#include "Graph/MappedFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    const char MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'B', 'I', 'N'};
+
+    uint64_t alignedPosition(uint64_t position)
+    {
+        return (position + 7) & ~uint64_t(7);
+    }
+
+    // Appends a section at the next aligned position and returns where it starts.
+    uint64_t writeSection(ofstream& output, uint64_t& position, const void* data, uint64_t size)
+    {
+        static const char padding[8] = {};
+        uint64_t start = alignedPosition(position);
+        output.write(padding, start - position);
+        output.write(static_cast<const char*>(data), size);
+        position = start + size;
+        return start;
+    }
+}
+
+GraphFile::GraphFile(const string& filePath)
+{
+    this->file = make_unique<MappedFile>(filePath);
+    if (this->file->size() < sizeof(MAGIC) + sizeof(uint32_t) || memcmp(this->file->data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw invalid_argument(filePath + " is not a graph file");
+    }
+
+    // The version comes first, headers of other versions may have another size.
+    uint32_t version;
+    memcpy(&version, this->file->data() + sizeof(MAGIC), sizeof(uint32_t));
+    if (version != VERSION)
+    {
+        throw invalid_argument(filePath + " has graph file version " + to_string(version) + ", expected " + to_string(VERSION));
+    }
+    if (this->file->size() < sizeof(Header))
+    {
+        throw invalid_argument(filePath + " is truncated");
+    }
+    memcpy(&this->header, this->file->data(), sizeof(Header));
+
+    uint64_t numberOfVertices = this->header.numberOfVertices;
+    this->offsets = this->rows(this->header.offsetsPosition, this->header.targetsPosition, this->targets);
+    this->weights = this->section<float>(this->header.weightsPosition, this->header.numberOfArcs);
+
+    this->reverseOffsets = nullptr;
+    this->sources = nullptr;
+    this->reverseWeights = nullptr;
+    this->sides = nullptr;
+    if (this->isDirected())
+    {
+        this->reverseOffsets = this->rows(this->header.reverseOffsetsPosition, this->header.sourcesPosition, this->sources);
+        this->reverseWeights = this->section<float>(this->header.reverseWeightsPosition, this->header.numberOfArcs);
+    }
+    else
+    {
+        this->sides = this->section<uint8_t>(this->header.sidesPosition, numberOfVertices);
+    }
+
+    this->nameOffsets = nullptr;
+    this->nameData = nullptr;
+    if (this->hasNames())
+    {
+        this->nameOffsets = this->section<uint32_t>(this->header.nameOffsetsPosition, numberOfVertices + 1);
+        this->nameData = this->section<char>(this->header.nameDataPosition, this->header.nameDataSize);
+        for (uint64_t v = 0; v < numberOfVertices; v++)
+        {
+            if (this->nameOffsets[v] > this->nameOffsets[v + 1])
+            {
+                throw invalid_argument(filePath + " has inconsistent names");
+            }
+        }
+        if (this->nameOffsets[0] != 0 || this->nameOffsets[numberOfVertices] != this->header.nameDataSize)
+        {
+            throw invalid_argument(filePath + " has inconsistent names");
+        }
+    }
+
+    this->coordinates = nullptr;
+    if (this->hasCoordinates())
+    {
+        this->coordinates = this->section<float>(this->header.coordinatesPosition, 2 * numberOfVertices);
+    }
+}
+
+// Checks a CSR section pair, offsets that climb from 0 to the number of arcs and heads that are vertices.
+const uint32_t* GraphFile::rows(uint64_t offsetsPosition, uint64_t targetsPosition, const uint32_t*& heads) const
+{
+    uint64_t numberOfVertices = this->header.numberOfVertices;
+    const uint32_t* offsets = this->section<uint32_t>(offsetsPosition, numberOfVertices + 1);
+    heads = this->section<uint32_t>(targetsPosition, this->header.numberOfArcs);
+    for (uint64_t v = 0; v < numberOfVertices; v++)
+    {
+        if (offsets[v] > offsets[v + 1])
+        {
+            throw invalid_argument(this->file->getPath() + " has inconsistent offsets");
+        }
+    }
+    if (offsets[0] != 0 || offsets[numberOfVertices] != this->header.numberOfArcs)
+    {
+        throw invalid_argument(this->file->getPath() + " has inconsistent offsets");
+    }
+    for (uint64_t arc = 0; arc < this->header.numberOfArcs; arc++)
+    {
+        if (heads[arc] >= numberOfVertices)
+        {
+            throw invalid_argument(this->file->getPath() + " has an arc to an unknown vertex");
+        }
+    }
+    return offsets;
+}
+
+template <typename T>
+const T* GraphFile::section(uint64_t position, uint64_t count) const
+{
+    if (position % alignof(T) != 0 || position > this->file->size() || count > (this->file->size() - position) / sizeof(T))
+    {
+        throw invalid_argument(this->file->getPath() + " is truncated");
+    }
+    return reinterpret_cast<const T*>(this->file->data() + position);
+}
+
+bool GraphFile::isGraphFile(const string& filePath)
+{
+    ifstream input(filePath, ios::in | ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!input.read(magic, sizeof(MAGIC)))
+    {
+        return false;
+    }
+    return memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void GraphFile::write(DirectedGraph& graph, const string& filePath)
+{
+    write(graph, filePath, vector<uint8_t>());
+}
+
+void GraphFile::write(UndirectedGraph& graph, const string& filePath)
+{
+    write(graph, filePath, graph.getBipartitionSides());
+}
+
+void GraphFile::write(AbstractGraph& graph, const string& filePath, const vector<uint8_t>& sides)
+{
+    shared_ptr<const CSRGraph> snapshot = graph.getSnapshot();
+    GraphStorage& storage = graph.getStorage();
+    uint32_t numberOfVertices = snapshot->getNumberOfVertices();
+
+    // Names equal to the vertex number, as in the unlabelled inputs, are left out and rebuilt on load.
+    bool withNames = false;
+    vector<uint32_t> nameOffsets(1, 0);
+    string nameData;
+    for (uint32_t v = 0; v < numberOfVertices; v++)
+    {
+        string name = storage.getName(v);
+        withNames = withNames || name != to_string(v + 1);
+        nameData += name;
+        nameOffsets.push_back(nameData.size());
+    }
+
+    bool withCoordinates = storage.getCoordinates().size() == 2 * numberOfVertices && numberOfVertices > 0;
+
+    ofstream output(filePath, ios::out | ios::binary | ios::trunc);
+    if (!output.is_open())
+    {
+        throw runtime_error("Could not open " + filePath);
+    }
+
+    Header header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = (snapshot->isDirected() ? DIRECTED : 0u) | (withNames ? NAMES : 0u) | (withCoordinates ? COORDINATES : 0u);
+    header.numberOfVertices = numberOfVertices;
+    header.numberOfArcs = snapshot->getNumberOfArcs();
+
+    // The header is written twice, first as a placeholder and then with the section positions filled in.
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    uint64_t position = sizeof(Header);
+    header.offsetsPosition = writeSection(output, position, snapshot->getOffsets().data(), snapshot->getOffsets().size() * sizeof(uint32_t));
+    header.targetsPosition = writeSection(output, position, snapshot->getTargets().data(), snapshot->getTargets().size() * sizeof(uint32_t));
+    header.weightsPosition = writeSection(output, position, snapshot->getWeights().data(), snapshot->getWeights().size() * sizeof(float));
+    if (snapshot->isDirected())
+    {
+        header.reverseOffsetsPosition = writeSection(output, position, snapshot->getReverseOffsets().data(), snapshot->getReverseOffsets().size() * sizeof(uint32_t));
+        header.sourcesPosition = writeSection(output, position, snapshot->getSources().data(), snapshot->getSources().size() * sizeof(uint32_t));
+        header.reverseWeightsPosition = writeSection(output, position, snapshot->getReverseWeights().data(), snapshot->getReverseWeights().size() * sizeof(float));
+    }
+    else
+    {
+        header.sidesPosition = writeSection(output, position, sides.data(), numberOfVertices);
+    }
+    if (withNames)
+    {
+        header.nameOffsetsPosition = writeSection(output, position, nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t));
+        header.nameDataPosition = writeSection(output, position, nameData.data(), nameData.size());
+        header.nameDataSize = nameData.size();
+    }
+    if (withCoordinates)
+    {
+        header.coordinatesPosition = writeSection(output, position, storage.getCoordinates().data(), 2 * numberOfVertices * sizeof(float));
+    }
+
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (!output)
+    {
+        throw runtime_error("Could not write " + filePath);
+    }
+}
+
+bool GraphFile::isDirected() const
+{
+    return (this->header.flags & DIRECTED) != 0;
+}
+
+uint32_t GraphFile::getNumberOfVertices() const
+{
+    return this->header.numberOfVertices;
+}
+
+uint32_t GraphFile::getNumberOfArcs() const
+{
+    return this->header.numberOfArcs;
+}
+
+const uint32_t* GraphFile::getOffsets() const
+{
+    return this->offsets;
+}
+
+const uint32_t* GraphFile::getTargets() const
+{
+    return this->targets;
+}
+
+const float* GraphFile::getWeights() const
+{
+    return this->weights;
+}
+
+const uint32_t* GraphFile::getReverseOffsets() const
+{
+    return this->reverseOffsets;
+}
+
+const uint32_t* GraphFile::getSources() const
+{
+    return this->sources;
+}
+
+const float* GraphFile::getReverseWeights() const
+{
+    return this->reverseWeights;
+}
+
+const uint8_t* GraphFile::getSides() const
+{
+    return this->sides;
+}
+
+bool GraphFile::hasNames() const
+{
+    return (this->header.flags & NAMES) != 0;
+}
+
+string GraphFile::getName(uint32_t vertex) const
+{
+    if (!this->hasNames())
+    {
+        return to_string(vertex + 1);
+    }
+    return string(this->nameData + this->nameOffsets[vertex], this->nameData + this->nameOffsets[vertex + 1]);
+}
+
+bool GraphFile::hasCoordinates() const
+{
+    return (this->header.flags & COORDINATES) != 0;
+}
+
+const float* GraphFile::getCoordinates() const
+{
+    return this->coordinates;
+}
+
+GraphFile::~GraphFile()
+= default;
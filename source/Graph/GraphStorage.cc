@@ -0,0 +1,377 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+
+#include "Graph/GraphStorage.h"
+#include "Graph/Node.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/EdgeIndex.h"
+#include "Graph/ArcAttributes.h"
+#include "Graph/GraphFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+GraphStorage::GraphStorage()
+{
+    this->nameOffsets.push_back(0);
+    this->connectionsPending = false;
+    this->nodesPending = false;
+}
+
+void GraphStorage::reserve(uint32_t numberOfNodes, uint32_t numberOfConnections)
+{
+    this->releaseFile();
+    this->nodeRecords.reserve(numberOfNodes);
+    this->outDegrees.reserve(numberOfNodes);
+    this->inDegrees.reserve(numberOfNodes);
+    this->nameOffsets.reserve(numberOfNodes + 1);
+    this->nodes.reserve(numberOfNodes);
+    this->connectionRecords.reserve(numberOfConnections);
+}
+
+void GraphStorage::load(shared_ptr<const GraphFile> file)
+{
+    if (this->getNumberOfNodes() != 0)
+    {
+        throw logic_error("A graph file can only be loaded into an empty graph");
+    }
+    this->invalidate();
+    this->snapshot = make_shared<const CSRGraph>(file);
+    this->file = std::move(file);
+    this->connectionsPending = true;
+    this->nodesPending = true;
+}
+
+// Threads the records through the rows of the file in row order, which gives the chains addConnection would have made.
+void GraphStorage::buildConnections() const
+{
+    if (!this->connectionsPending)
+    {
+        return;
+    }
+    uint32_t numberOfNodes = this->file->getNumberOfVertices();
+    const uint32_t* offsets = this->file->getOffsets();
+    const uint32_t* targets = this->file->getTargets();
+    const float* weights = this->file->getWeights();
+    bool goesBothWays = !this->file->isDirected();
+
+    this->nodeRecords.assign(numberOfNodes, {NONE, NONE, NONE, NONE});
+    this->outDegrees.assign(numberOfNodes, 0);
+    this->inDegrees.assign(numberOfNodes, 0);
+    this->connectionRecords.resize(this->file->getNumberOfArcs());
+    for (uint32_t u = 0; u < numberOfNodes; u++)
+    {
+        NodeRecord& start = this->nodeRecords[u];
+        if (offsets[u] < offsets[u + 1])
+        {
+            start.firstOutgoing = offsets[u];
+            start.lastOutgoing = offsets[u + 1] - 1;
+        }
+        this->outDegrees[u] = offsets[u + 1] - offsets[u];
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            uint32_t next = arc + 1 < offsets[u + 1] ? arc + 1 : NONE;
+            this->connectionRecords[arc] = {u, targets[arc], weights[arc], next, NONE, goesBothWays};
+
+            NodeRecord& end = this->nodeRecords[targets[arc]];
+            if (end.lastIncoming == NONE)
+            {
+                end.firstIncoming = arc;
+            }
+            else
+            {
+                this->connectionRecords[end.lastIncoming].nextIncoming = arc;
+            }
+            end.lastIncoming = arc;
+            this->inDegrees[targets[arc]]++;
+        }
+    }
+    this->connectionsPending = false;
+}
+
+void GraphStorage::buildNodes()
+{
+    if (!this->nodesPending)
+    {
+        return;
+    }
+    uint32_t numberOfNodes = this->getNumberOfNodes();
+    this->nodes.reserve(numberOfNodes);
+    for (uint32_t v = 0; v < numberOfNodes; v++)
+    {
+        this->nodes.push_back(make_shared<Node>(v + 1, this->getName(v)));
+        this->nodes.back()->attach(this->shared_from_this(), v);
+    }
+    this->nodesPending = false;
+}
+
+// Copies what is still read from the file into the storage, so that nodes can be added.
+void GraphStorage::releaseFile()
+{
+    if (!this->file)
+    {
+        return;
+    }
+    this->buildConnections();
+    this->buildNodes();
+    uint32_t numberOfNodes = this->getNumberOfNodes();
+    for (uint32_t v = 0; v < numberOfNodes; v++)
+    {
+        string name = this->file->getName(v);
+        this->nameData.insert(this->nameData.end(), name.begin(), name.end());
+        this->nameOffsets.push_back(this->nameData.size());
+    }
+    if (this->file->hasCoordinates())
+    {
+        this->coordinates.assign(this->file->getCoordinates(), this->file->getCoordinates() + 2 * numberOfNodes);
+    }
+    this->file.reset();
+}
+
+uint32_t GraphStorage::addNode(const shared_ptr<Node>& node)
+{
+    this->releaseFile();
+    uint32_t id = this->nodeRecords.size();
+
+    string name = node->getName();
+    this->nameData.insert(this->nameData.end(), name.begin(), name.end());
+    this->nameOffsets.push_back(this->nameData.size());
+
+    this->nodeRecords.push_back({NONE, NONE, NONE, NONE});
+    this->outDegrees.push_back(0);
+    this->inDegrees.push_back(0);
+    if (!this->coordinates.empty())
+    {
+        this->coordinates.resize(2 * (id + 1), numeric_limits<float>::quiet_NaN());
+    }
+    this->nodes.push_back(node);
+    node->attach(this->shared_from_this(), id);
+
+    this->invalidate();
+    return id;
+}
+
+uint32_t GraphStorage::addConnection(uint32_t startNode, uint32_t endNode, float weight, bool goesBothWays)
+{
+    this->buildConnections();
+    uint32_t id = this->connectionRecords.size();
+    this->connectionRecords.push_back({startNode, endNode, weight, NONE, NONE, goesBothWays});
+
+    // Append at the tail of both chains so that they keep insertion order.
+    NodeRecord& start = this->nodeRecords[startNode];
+    if (start.lastOutgoing == NONE)
+    {
+        start.firstOutgoing = id;
+    }
+    else
+    {
+        this->connectionRecords[start.lastOutgoing].nextOutgoing = id;
+    }
+    start.lastOutgoing = id;
+    this->outDegrees[startNode]++;
+
+    NodeRecord& end = this->nodeRecords[endNode];
+    if (end.lastIncoming == NONE)
+    {
+        end.firstIncoming = id;
+    }
+    else
+    {
+        this->connectionRecords[end.lastIncoming].nextIncoming = id;
+    }
+    end.lastIncoming = id;
+    this->inDegrees[endNode]++;
+
+    this->invalidate();
+    return id;
+}
+
+uint32_t GraphStorage::getNumberOfNodes() const
+{
+    return this->connectionsPending ? this->file->getNumberOfVertices() : this->nodeRecords.size();
+}
+
+uint32_t GraphStorage::getNumberOfConnections() const
+{
+    return this->connectionsPending ? this->file->getNumberOfArcs() : this->connectionRecords.size();
+}
+
+const shared_ptr<Node>& GraphStorage::getNode(uint32_t node)
+{
+    this->buildNodes();
+    return this->nodes[node];
+}
+
+const vector<shared_ptr<Node>>& GraphStorage::getNodes()
+{
+    this->buildNodes();
+    return this->nodes;
+}
+
+string GraphStorage::getName(uint32_t node) const
+{
+    if (this->file)
+    {
+        return this->file->getName(node);
+    }
+    return string(this->nameData.begin() + this->nameOffsets[node], this->nameData.begin() + this->nameOffsets[node + 1]);
+}
+
+uint32_t GraphStorage::firstOutgoing(uint32_t node) const
+{
+    this->buildConnections();
+    return this->nodeRecords[node].firstOutgoing;
+}
+
+uint32_t GraphStorage::firstIncoming(uint32_t node) const
+{
+    this->buildConnections();
+    return this->nodeRecords[node].firstIncoming;
+}
+
+uint32_t GraphStorage::nextOutgoing(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].nextOutgoing;
+}
+
+uint32_t GraphStorage::nextIncoming(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].nextIncoming;
+}
+
+uint32_t GraphStorage::outDegree(uint32_t node) const
+{
+    this->buildConnections();
+    return this->outDegrees[node];
+}
+
+uint32_t GraphStorage::inDegree(uint32_t node) const
+{
+    this->buildConnections();
+    return this->inDegrees[node];
+}
+
+const vector<uint32_t>& GraphStorage::getOutDegrees() const
+{
+    this->buildConnections();
+    return this->outDegrees;
+}
+
+const vector<uint32_t>& GraphStorage::getInDegrees() const
+{
+    this->buildConnections();
+    return this->inDegrees;
+}
+
+const GraphStorage::ConnectionRecord* GraphStorage::getConnectionRecords() const
+{
+    this->buildConnections();
+    return this->connectionRecords.data();
+}
+
+uint32_t GraphStorage::getStartNode(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].startNode;
+}
+
+uint32_t GraphStorage::getEndNode(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].endNode;
+}
+
+float GraphStorage::getWeight(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].weight;
+}
+
+bool GraphStorage::getGoesBothWays(uint32_t connection) const
+{
+    this->buildConnections();
+    return this->connectionRecords[connection].goesBothWays;
+}
+
+void GraphStorage::setWeight(uint32_t connection, float weight)
+{
+    this->buildConnections();
+    this->connectionRecords[connection].weight = weight;
+    this->snapshot.reset(); // The edge index only holds ids, so it stays valid
+}
+
+void GraphStorage::setGoesBothWays(uint32_t connection, bool goesBothWays)
+{
+    this->buildConnections();
+    this->connectionRecords[connection].goesBothWays = goesBothWays;
+}
+
+void GraphStorage::setCoordinates(uint32_t node, float x, float y)
+{
+    this->releaseFile();
+    if (this->coordinates.size() < 2 * this->nodeRecords.size())
+    {
+        this->coordinates.resize(2 * this->nodeRecords.size(), numeric_limits<float>::quiet_NaN());
+    }
+    this->coordinates[2 * node] = x;
+    this->coordinates[2 * node + 1] = y;
+}
+
+bool GraphStorage::hasCoordinates() const
+{
+    return !this->getCoordinates().empty();
+}
+
+ArrayView<float> GraphStorage::getCoordinates() const
+{
+    if (this->file)
+    {
+        return this->file->hasCoordinates() ? ArrayView<float>(this->file->getCoordinates(), 2 * this->getNumberOfNodes()) : ArrayView<float>();
+    }
+    return this->coordinates;
+}
+
+void GraphStorage::setArcAttributes(shared_ptr<ArcAttributes> arcAttributes)
+{
+    this->arcAttributes = std::move(arcAttributes);
+}
+
+const shared_ptr<ArcAttributes>& GraphStorage::getArcAttributes() const
+{
+    return this->arcAttributes;
+}
+
+shared_ptr<const CSRGraph> GraphStorage::getSnapshot(bool directed)
+{
+    if (!this->snapshot)
+    {
+        this->snapshot = make_shared<const CSRGraph>(*this, directed);
+    }
+    return this->snapshot;
+}
+
+uint32_t GraphStorage::findConnection(uint32_t startNode, uint32_t endNode)
+{
+    this->buildConnections();
+    if (!this->edgeIndex)
+    {
+        this->edgeIndex = make_shared<const EdgeIndex>(*this);
+    }
+    return this->edgeIndex->find(startNode, endNode);
+}
+
+void GraphStorage::invalidate()
+{
+    this->snapshot.reset();
+    this->edgeIndex.reset();
+}
+
+GraphStorage::~GraphStorage()
+= default;
@@ -0,0 +1,455 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Graph/Landmarks.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/IndexedHeap.h"
+#include "Graph/MappedFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+namespace
+{
+    const char MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'A', 'L', 'T'};
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t directed;
+        uint32_t numberOfVertices;
+        uint32_t numberOfLandmarks;
+        uint32_t numberOfArcs; // Arcs and fingerprint of the snapshot the tables were computed for
+        uint32_t reserved;
+        uint64_t graphFingerprint;
+        uint64_t landmarksPosition;
+        uint64_t fromLandmarksPosition;
+        uint64_t toLandmarksPosition;
+    };
+
+    // Dijkstra over the rows of one direction of the snapshot. Parents and the settling order are filled when asked for.
+    void shortestPathTree(ArrayView<uint32_t> offsets, ArrayView<uint32_t> heads, ArrayView<float> weights, int source,
+                          vector<int>& distances, vector<int>* parents, vector<int>* order)
+    {
+        int numberOfVertices = offsets.size() - 1;
+        distances.assign(numberOfVertices, Landmarks::UNREACHABLE);
+        if (parents != nullptr)
+        {
+            parents->assign(numberOfVertices, -1);
+        }
+        if (order != nullptr)
+        {
+            order->clear();
+        }
+
+        IndexedHeap<int> heap(numberOfVertices);
+        distances[source] = 0;
+        heap.push(source, 0);
+        while (!heap.empty())
+        {
+            int u = heap.pop();
+            if (order != nullptr)
+            {
+                order->push_back(u);
+            }
+            for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+            {
+                int v = heads[arc];
+                if (static_cast<int>(weights[arc]) < 0)
+                {
+                    throw invalid_argument("Landmarks need non-negative weights");
+                }
+                int64_t distanceOfV = static_cast<int64_t>(distances[u]) + static_cast<int>(weights[arc]);
+                if (distanceOfV < distances[v])
+                {
+                    distances[v] = distanceOfV;
+                    if (parents != nullptr)
+                    {
+                        (*parents)[v] = u;
+                    }
+                    heap.pushOrDecrease(v, distanceOfV);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    vector<T> readSection(const MappedFile& file, uint64_t position, uint64_t count)
+    {
+        if (position % alignof(T) != 0 || position > file.size() || count > (file.size() - position) / sizeof(T))
+        {
+            throw invalid_argument(file.getPath() + " is truncated");
+        }
+        vector<T> section(count);
+        memcpy(section.data(), file.data() + position, count * sizeof(T));
+        return section;
+    }
+
+    uint64_t writeSection(ofstream& output, uint64_t& position, const void* data, uint64_t size)
+    {
+        static const char padding[8] = {};
+        uint64_t start = (position + 7) & ~uint64_t(7);
+        output.write(padding, start - position);
+        output.write(static_cast<const char*>(data), size);
+        position = start + size;
+        return start;
+    }
+}
+
+Landmarks::Landmarks(shared_ptr<const CSRGraph> snapshot, int numberOfLandmarks, LandmarkSelection selection)
+{
+    int numberOfVertices = snapshot->getNumberOfVertices();
+    if (numberOfLandmarks < 1 || numberOfLandmarks > numberOfVertices)
+    {
+        throw invalid_argument("Invalid number of landmarks " + to_string(numberOfLandmarks));
+    }
+    this->snapshot = std::move(snapshot);
+    this->fromLandmarks = vector<int32_t>(static_cast<size_t>(numberOfVertices) * numberOfLandmarks);
+
+    // Selection needs the distances from the landmarks chosen so far, so those tables are filled one at a time here.
+    // The first landmark is the vertex farthest from vertex 0 and avoid picks its roots with a fixed seed, so the same
+    // graph always gets the same landmarks.
+    mt19937 random(1);
+    while (static_cast<int>(this->landmarks.size()) < numberOfLandmarks)
+    {
+        int landmark;
+        if (this->landmarks.empty())
+        {
+            vector<int> distances;
+            shortestPathTree(this->snapshot->getOffsets(), this->snapshot->getTargets(), this->snapshot->getWeights(), 0, distances, nullptr, nullptr);
+            landmark = max_element(distances.begin(), distances.end()) - distances.begin();
+        }
+        else if (selection == LandmarkSelection::AVOID)
+        {
+            landmark = this->selectAvoiding(random() % numberOfVertices);
+        }
+        else
+        {
+            landmark = this->selectFarthest();
+        }
+        this->landmarks.push_back(landmark);
+        this->fillTable(this->fromLandmarks, this->landmarks.size() - 1, true);
+    }
+
+    this->fillTables(false, this->snapshot->isDirected());
+}
+
+Landmarks::Landmarks(shared_ptr<const CSRGraph> snapshot, const vector<int>& landmarks)
+{
+    for (int landmark : landmarks)
+    {
+        if (landmark < 0 || landmark >= snapshot->getNumberOfVertices())
+        {
+            throw invalid_argument("Invalid landmark " + to_string(landmark + 1));
+        }
+    }
+    if (landmarks.empty())
+    {
+        throw invalid_argument("Invalid number of landmarks 0");
+    }
+    this->snapshot = std::move(snapshot);
+    this->landmarks = landmarks;
+    this->fromLandmarks = vector<int32_t>(static_cast<size_t>(this->snapshot->getNumberOfVertices()) * landmarks.size());
+    this->fillTables(true, this->snapshot->isDirected());
+}
+
+Landmarks::Landmarks(shared_ptr<const CSRGraph> snapshot, const string& filePath)
+{
+    MappedFile file(filePath);
+    Header header = {};
+    if (file.size() < sizeof(Header) || memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw invalid_argument(filePath + " is not a landmark file");
+    }
+    memcpy(&header, file.data(), sizeof(Header));
+    if (header.version != VERSION)
+    {
+        throw invalid_argument(filePath + " has landmark file version " + to_string(header.version) + ", expected " + to_string(VERSION));
+    }
+    if (header.numberOfVertices != static_cast<uint32_t>(snapshot->getNumberOfVertices()) || (header.directed != 0) != snapshot->isDirected()
+        || header.numberOfArcs != static_cast<uint32_t>(snapshot->getNumberOfArcs()) || header.graphFingerprint != snapshot->getFingerprint()
+        || header.numberOfLandmarks == 0)
+    {
+        throw invalid_argument(filePath + " does not belong to this graph");
+    }
+
+    uint64_t tableSize = static_cast<uint64_t>(header.numberOfVertices) * header.numberOfLandmarks;
+    this->snapshot = std::move(snapshot);
+    this->landmarks = readSection<int>(file, header.landmarksPosition, header.numberOfLandmarks);
+    this->fromLandmarks = readSection<int32_t>(file, header.fromLandmarksPosition, tableSize);
+    if (header.directed != 0)
+    {
+        this->toLandmarks = readSection<int32_t>(file, header.toLandmarksPosition, tableSize);
+    }
+    for (int landmark : this->landmarks)
+    {
+        if (landmark < 0 || landmark >= static_cast<int>(header.numberOfVertices))
+        {
+            throw invalid_argument(filePath + " has a landmark out of the graph");
+        }
+    }
+}
+
+void Landmarks::fillTables(bool forward, bool backward)
+{
+    // One Dijkstra per landmark and direction, spread over the cores. Every run writes its own column of the tables.
+    vector<pair<int, bool>> runs;
+    for (int i = 0; i < static_cast<int>(this->landmarks.size()); i++)
+    {
+        if (forward)
+        {
+            runs.emplace_back(i, true);
+        }
+        if (backward)
+        {
+            runs.emplace_back(i, false);
+        }
+    }
+    if (backward && this->toLandmarks.empty())
+    {
+        this->toLandmarks = vector<int32_t>(this->fromLandmarks.size());
+    }
+
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    vector<thread> threads;
+    for (int t = 0; t < numberOfThreads && t < static_cast<int>(runs.size()); t++)
+    {
+        threads.emplace_back([this, &runs, t, numberOfThreads]()
+        {
+            for (size_t run = t; run < runs.size(); run += numberOfThreads)
+            {
+                vector<int32_t>& table = runs[run].second ? this->fromLandmarks : this->toLandmarks;
+                this->fillTable(table, runs[run].first, runs[run].second);
+            }
+        });
+    }
+    for (thread& worker : threads)
+    {
+        worker.join();
+    }
+}
+
+void Landmarks::fillTable(vector<int32_t>& table, int landmark, bool forward)
+{
+    // Distances to a landmark are distances from it over the reversed arcs.
+    vector<int> distances;
+    if (forward)
+    {
+        shortestPathTree(this->snapshot->getOffsets(), this->snapshot->getTargets(), this->snapshot->getWeights(),
+                         this->landmarks[landmark], distances, nullptr, nullptr);
+    }
+    else
+    {
+        shortestPathTree(this->snapshot->getReverseOffsets(), this->snapshot->getSources(), this->snapshot->getReverseWeights(),
+                         this->landmarks[landmark], distances, nullptr, nullptr);
+    }
+
+    size_t k = this->fromLandmarks.size() / this->snapshot->getNumberOfVertices();
+    for (size_t v = 0; v < distances.size(); v++)
+    {
+        table[v * k + landmark] = distances[v];
+    }
+}
+
+int Landmarks::selectFarthest() const
+{
+    // Vertices no landmark reaches count as the farthest, so every component gets a landmark before any gets two.
+    size_t k = this->fromLandmarks.size() / this->snapshot->getNumberOfVertices();
+    int farthest = -1;
+    int farthestDistance = -1;
+    for (int v = 0; v < this->snapshot->getNumberOfVertices(); v++)
+    {
+        if (find(this->landmarks.begin(), this->landmarks.end(), v) != this->landmarks.end())
+        {
+            continue;
+        }
+        int nearest = Landmarks::UNREACHABLE;
+        for (size_t i = 0; i < this->landmarks.size(); i++)
+        {
+            nearest = min(nearest, this->fromLandmarks[v * k + i]);
+        }
+        if (nearest > farthestDistance)
+        {
+            farthest = v;
+            farthestDistance = nearest;
+        }
+    }
+    return farthest;
+}
+
+int Landmarks::selectAvoiding(int root)
+{
+    // Goldberg and Werneck's avoid: in the shortest path tree of a root, a vertex weighs the gap between its distance
+    // from the root and the current lower bound for it. Subtrees that hold a landmark weigh nothing, and the new landmark
+    // is the leaf reached by always descending into the heaviest subtree.
+    ArrayView<uint32_t> offsets = this->snapshot->getOffsets();
+    size_t k = this->fromLandmarks.size() / this->snapshot->getNumberOfVertices();
+    vector<int> distances;
+    vector<int> parents;
+    vector<int> order;
+    shortestPathTree(offsets, this->snapshot->getTargets(), this->snapshot->getWeights(), root, distances, &parents, &order);
+
+    vector<long long> sizes(this->snapshot->getNumberOfVertices(), 0);
+    vector<char> holdsLandmark(this->snapshot->getNumberOfVertices(), 0);
+    for (int landmark : this->landmarks)
+    {
+        holdsLandmark[landmark] = 1;
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        int v = *it;
+        int bound = 0;
+        for (size_t i = 0; i < this->landmarks.size(); i++)
+        {
+            int fromRoot = this->fromLandmarks[root * k + i];
+            int fromV = this->fromLandmarks[v * k + i];
+            if (fromRoot < Landmarks::UNREACHABLE && fromV < Landmarks::UNREACHABLE)
+            {
+                bound = max(bound, fromV - fromRoot);
+            }
+        }
+        sizes[v] += distances[v] - bound;
+        if (holdsLandmark[v])
+        {
+            sizes[v] = 0;
+        }
+        if (parents[v] != -1)
+        {
+            holdsLandmark[parents[v]] = holdsLandmark[parents[v]] || holdsLandmark[v];
+            sizes[parents[v]] += sizes[v];
+        }
+    }
+
+    // Children of every tree vertex, bucketed by parent with a counting sort.
+    vector<uint32_t> childOffsets(this->snapshot->getNumberOfVertices() + 1, 0);
+    for (int v : order)
+    {
+        if (parents[v] != -1)
+        {
+            childOffsets[parents[v] + 1]++;
+        }
+    }
+    for (size_t v = 0; v + 1 < childOffsets.size(); v++)
+    {
+        childOffsets[v + 1] += childOffsets[v];
+    }
+    vector<uint32_t> position(childOffsets.begin(), childOffsets.end() - 1);
+    vector<int> children(order.size());
+    for (int v : order)
+    {
+        if (parents[v] != -1)
+        {
+            children[position[parents[v]]++] = v;
+        }
+    }
+
+    if (sizes[root] == 0)
+    {
+        return this->selectFarthest(); // The current landmarks already bound the whole tree exactly
+    }
+    int leaf = root;
+    while (childOffsets[leaf] < childOffsets[leaf + 1])
+    {
+        int heaviest = -1;
+        for (uint32_t c = childOffsets[leaf]; c < childOffsets[leaf + 1]; c++)
+        {
+            if (heaviest == -1 || sizes[children[c]] > sizes[heaviest])
+            {
+                heaviest = children[c];
+            }
+        }
+        if (sizes[heaviest] == 0)
+        {
+            break;
+        }
+        leaf = heaviest;
+    }
+    return leaf;
+}
+
+void Landmarks::save(const string& filePath) const
+{
+    ofstream output(filePath, ios::out | ios::binary | ios::trunc);
+    if (!output.is_open())
+    {
+        throw runtime_error("Could not open " + filePath);
+    }
+
+    Header header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.directed = this->snapshot->isDirected() ? 1 : 0;
+    header.numberOfVertices = this->snapshot->getNumberOfVertices();
+    header.numberOfLandmarks = this->landmarks.size();
+    header.numberOfArcs = this->snapshot->getNumberOfArcs();
+    header.graphFingerprint = this->snapshot->getFingerprint();
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    uint64_t position = sizeof(Header);
+    header.landmarksPosition = writeSection(output, position, this->landmarks.data(), this->landmarks.size() * sizeof(int));
+    header.fromLandmarksPosition = writeSection(output, position, this->fromLandmarks.data(), this->fromLandmarks.size() * sizeof(int32_t));
+    if (!this->toLandmarks.empty())
+    {
+        header.toLandmarksPosition = writeSection(output, position, this->toLandmarks.data(), this->toLandmarks.size() * sizeof(int32_t));
+    }
+
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (!output)
+    {
+        throw runtime_error("Could not write " + filePath);
+    }
+}
+
+int Landmarks::lowerBound(int vertex, int target) const
+{
+    // d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L). Terms with an unreachable entry bound nothing.
+    size_t k = this->landmarks.size();
+    const int32_t* fromV = &this->fromLandmarks[vertex * k];
+    const int32_t* fromT = &this->fromLandmarks[target * k];
+    const vector<int32_t>& to = this->toLandmarks.empty() ? this->fromLandmarks : this->toLandmarks;
+    const int32_t* toV = &to[vertex * k];
+    const int32_t* toT = &to[target * k];
+
+    int bound = 0;
+    for (size_t i = 0; i < k; i++)
+    {
+        if (fromV[i] < UNREACHABLE && fromT[i] < UNREACHABLE)
+        {
+            bound = max(bound, fromT[i] - fromV[i]);
+        }
+        if (toV[i] < UNREACHABLE && toT[i] < UNREACHABLE)
+        {
+            bound = max(bound, toV[i] - toT[i]);
+        }
+    }
+    return bound;
+}
+
+int Landmarks::getNumberOfLandmarks() const
+{
+    return this->landmarks.size();
+}
+
+const vector<int>& Landmarks::getLandmarks() const
+{
+    return this->landmarks;
+}
+
+const shared_ptr<const CSRGraph>& Landmarks::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+Landmarks::~Landmarks()
+= default;
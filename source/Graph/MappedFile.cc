@@ -0,0 +1,112 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Graph/MappedFile.h"
+
+using namespace std;
+using namespace GraphModule;
+
+MappedFile::MappedFile(const string& filePath)
+{
+    this->filePath = filePath;
+    this->mappedData = nullptr;
+    this->mappedSize = 0;
+    this->writable = false;
+
+    int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        throw runtime_error("Could not open " + filePath);
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) < 0)
+    {
+        close(fileDescriptor);
+        throw runtime_error("Could not read the size of " + filePath);
+    }
+
+    this->mappedSize = fileStatus.st_size;
+    if (this->mappedSize > 0) // mmap rejects empty mappings
+    {
+        void* mapping = mmap(nullptr, this->mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fileDescriptor);
+            throw runtime_error("Could not map " + filePath);
+        }
+        madvise(mapping, this->mappedSize, MADV_SEQUENTIAL);
+        this->mappedData = static_cast<char*>(mapping);
+    }
+
+    close(fileDescriptor); // The mapping keeps its own reference to the file
+}
+
+MappedFile::MappedFile(const string& filePath, size_t size)
+{
+    this->filePath = filePath;
+    this->mappedData = nullptr;
+    this->mappedSize = size;
+    this->writable = true;
+
+    int fileDescriptor = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0)
+    {
+        throw runtime_error("Could not create " + filePath);
+    }
+    if (ftruncate(fileDescriptor, size) < 0)
+    {
+        close(fileDescriptor);
+        throw runtime_error("Could not resize " + filePath);
+    }
+
+    if (this->mappedSize > 0)
+    {
+        void* mapping = mmap(nullptr, this->mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fileDescriptor);
+            throw runtime_error("Could not map " + filePath);
+        }
+        this->mappedData = static_cast<char*>(mapping);
+    }
+
+    close(fileDescriptor);
+}
+
+const char* MappedFile::data() const
+{
+    return this->mappedData;
+}
+
+char* MappedFile::writableData()
+{
+    if (!this->writable)
+    {
+        throw logic_error(this->filePath + " is mapped read-only");
+    }
+    return this->mappedData;
+}
+
+size_t MappedFile::size() const
+{
+    return this->mappedSize;
+}
+
+const string& MappedFile::getPath() const
+{
+    return this->filePath;
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->mappedData != nullptr)
+    {
+        munmap(this->mappedData, this->mappedSize);
+    }
+}
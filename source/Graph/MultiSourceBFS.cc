@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph/MultiSourceBFS.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+MultiSourceBFS::MultiSourceBFS(shared_ptr<const CSRGraph> snapshot)
+{
+    this->snapshot = std::move(snapshot);
+}
+
+vector<int> MultiSourceBFS::hopDistances(const vector<int>& sources)
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    for (int source : sources)
+    {
+        if (source < 0 || source >= numberOfVertices)
+        {
+            throw invalid_argument("Invalid start vertex " + to_string(source));
+        }
+    }
+
+    // Every cell is written by the one thread that settles its vertex.
+    vector<int> distances(sources.size() * static_cast<size_t>(numberOfVertices), INFINITE_DISTANCE);
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    this->run(sources, numberOfThreads, [&distances, numberOfVertices](int, int i, int v, int level)
+    {
+        distances[static_cast<size_t>(i) * numberOfVertices + v] = level;
+    });
+    return distances;
+}
+
+vector<MultiSourceBFS::Statistics> MultiSourceBFS::statistics(const vector<int>& sources)
+{
+    int numberOfVertices = this->snapshot->getNumberOfVertices();
+    for (int source : sources)
+    {
+        if (source < 0 || source >= numberOfVertices)
+        {
+            throw invalid_argument("Invalid start vertex " + to_string(source));
+        }
+    }
+
+    // Each thread adds up what it settles in a copy of its own, merged at the end.
+    int numberOfThreads = max(1u, thread::hardware_concurrency());
+    Statistics empty = {0, 0, 0, 0};
+    vector<vector<Statistics>> partial(numberOfThreads, vector<Statistics>(sources.size(), empty));
+    this->run(sources, numberOfThreads, [&partial](int t, int i, int, int level)
+    {
+        Statistics& statistics = partial[t][i];
+        statistics.eccentricity = max(statistics.eccentricity, level);
+        statistics.numberOfReached++;
+        statistics.totalDistance += level;
+    });
+
+    vector<Statistics> merged(sources.size(), empty);
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        for (const vector<Statistics>& statistics : partial)
+        {
+            merged[i].eccentricity = max(merged[i].eccentricity, statistics[i].eccentricity);
+            merged[i].numberOfReached += statistics[i].numberOfReached;
+            merged[i].totalDistance += statistics[i].totalDistance;
+        }
+        merged[i].closeness = merged[i].totalDistance == 0 ? 0 : (merged[i].numberOfReached - 1) / static_cast<double>(merged[i].totalDistance);
+    }
+    return merged;
+}
+
+const shared_ptr<const CSRGraph>& MultiSourceBFS::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+MultiSourceBFS::~MultiSourceBFS()
+= default;
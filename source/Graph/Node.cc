@@ -2,9 +2,12 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <utility>
+#include <stdexcept>
 
 #include "Graph/Node.h"
 #include "Graph/Connection.h"
+#include "Graph/GraphStorage.h"
 
 using namespace std;
 using namespace GraphModule;
@@ -12,7 +15,8 @@ using namespace GraphModule;
 Node::Node(int number, string name)
 {
     this->number = number;
-    this->name = name;
+    this->name = std::move(name);
+    this->id = GraphStorage::NONE;
 }
 
 int Node::getNumber()
@@ -25,101 +29,95 @@ string Node::getName()
     return name;
 }
 
-vector<shared_ptr<Connection>> Node::getConnections()
+uint32_t Node::getId()
+{
+    return this->id;
+}
+
+void Node::attach(const shared_ptr<GraphStorage>& storage, uint32_t id)
+{
+    this->storage = storage;
+    this->id = id;
+}
+
+// Null while the node is in no graph.
+shared_ptr<GraphStorage> Node::lockStorage() const
 {
-    vector<shared_ptr<Connection>> connectionsToReturn = vector<shared_ptr<Connection>>();
-    for (auto & connection : this->connections)
+    if (this->id == GraphStorage::NONE)
     {
-        connectionsToReturn.push_back(connection.lock());
+        return nullptr;
     }
+    shared_ptr<GraphStorage> storage = this->storage.lock();
+    if (!storage)
+    {
+        throw logic_error("Node " + to_string(this->number) + " is used after its graph was destroyed");
+    }
+    return storage;
+}
 
-    return connectionsToReturn;
+// The range reads the storage in place, the graph has to outlive it.
+NeighbourRange Node::outNeighbours()
+{
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    if (!storage)
+    {
+        return {};
+    }
+    return NeighbourRange(storage.get(), this->id, false);
 }
 
-void Node::addConnections(const vector<weak_ptr<Connection>>& connectionsToAdd)
+NeighbourRange Node::inNeighbours()
 {
-    for (const auto & connIndex : connectionsToAdd)
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    if (!storage)
     {
-        this->addConnection(connIndex);
+        return {};
     }
+    return NeighbourRange(storage.get(), this->id, true);
 }
 
-void Node::addConnection(const weak_ptr<Connection>& connectionToAdd)
+vector<shared_ptr<Connection>> Node::getConnections()
 {
-    this->connections.push_back(connectionToAdd);
+    return this->getOutgoingConnections();
 }
 
 tuple<bool, shared_ptr<Connection>> Node::getConnectionWith(const shared_ptr<Node>& NodeConnectedOnTheOtherEnd)
-{    
-    for (long unsigned int connIndex = 0; connIndex < this->connections.size(); connIndex++)
-    {
-        weak_ptr<Connection> conn = this->connections[connIndex];
-
-        shared_ptr<Node> endNode = (conn.lock())->getEndNode();
-
-        //cout << "\tChecking if " << this->number << " has connection with " << endNode->getNumber() << ": ";
-
-        if ((endNode->getNumber() == NodeConnectedOnTheOtherEnd->getNumber()))
-        {
-            //cout << "YES! node connected: "<< NodeConnectedOnTheOtherEnd->getNumber()<<endl;
-            return make_tuple(true, conn.lock());
-        }
-        else
-        {
-            if (connIndex == this->connections.size() - 1)
-            {
-                //cout << "NO! node connected: "<< NodeConnectedOnTheOtherEnd->getNumber()<<endl;
-                return make_tuple(false, nullptr);
-            }
-            //cout << "NO! node connected: "<< NodeConnectedOnTheOtherEnd->getNumber()<<endl;
-            continue;
-        }
-    }
-    return {};
+{
+    shared_ptr<Connection> connection = this->getOutgoingConnectionTo(NodeConnectedOnTheOtherEnd);
+
+    return make_tuple(connection != nullptr, connection);
 }
 
 shared_ptr<Connection> Node::getOutgoingConnectionTo(const shared_ptr<Node>& NodeConnectedOnTheOtherEnd)
 {
-    for (const auto& conn : this->outgoingConnections)
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    if (!storage)
     {
-        shared_ptr<Node> endNode = (conn.lock())->getEndNode();
+        return nullptr;
+    }
 
-        if (endNode == NodeConnectedOnTheOtherEnd)
-        {
-            return conn.lock();
-        }
+    uint32_t conn = storage->findConnection(this->id, NodeConnectedOnTheOtherEnd->getId());
+    if (conn == GraphStorage::NONE)
+    {
+        return nullptr;
     }
-    return {};
+    return make_shared<Connection>(storage, conn);
 }
 
 vector<shared_ptr<Node>> Node::getNeighbours()
 {
-    vector<shared_ptr<Node>> neighbours;
-
-    for (const auto& conn : this->connections)
-    {
-        shared_ptr<Node> startNode = (conn.lock())->getStartNode();
-        shared_ptr<Node> endNode = (conn.lock())->getEndNode();
-
-        if (startNode.get() == this)
-        {
-            neighbours.push_back(endNode);
-        }
-        else if (endNode.get() == this)
-        {
-            neighbours.push_back(startNode);
-        }
-    }
-
-    return neighbours;
+    return this->getOutgoingNeighbours();
 }
 
 vector<shared_ptr<Connection>> Node::getIncomingConnections()
 {
-    vector<shared_ptr<Connection>> incomingConnectionsToReturn = vector<shared_ptr<Connection>>();
-    for (const auto & incomingConnection : this->incomingConnections)
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    NeighbourRange neighbours = this->inNeighbours();
+    vector<shared_ptr<Connection>> incomingConnectionsToReturn;
+    incomingConnectionsToReturn.reserve(neighbours.size());
+    for (auto it = neighbours.begin(); it != neighbours.end(); ++it)
     {
-        incomingConnectionsToReturn.push_back(incomingConnection.lock());
+        incomingConnectionsToReturn.push_back(make_shared<Connection>(storage, it.getConnection()));
     }
 
     return incomingConnectionsToReturn;
@@ -127,10 +125,13 @@ vector<shared_ptr<Connection>> Node::getIncomingConnections()
 
 vector<shared_ptr<Connection>> Node::getOutgoingConnections()
 {
-    vector <shared_ptr<Connection>> outgoingConnectionsToReturn = vector<shared_ptr<Connection>>();
-    for (const auto & outgoingConnection : this->outgoingConnections)
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    NeighbourRange neighbours = this->outNeighbours();
+    vector<shared_ptr<Connection>> outgoingConnectionsToReturn;
+    outgoingConnectionsToReturn.reserve(neighbours.size());
+    for (auto it = neighbours.begin(); it != neighbours.end(); ++it)
     {
-        outgoingConnectionsToReturn.push_back(outgoingConnection.lock());
+        outgoingConnectionsToReturn.push_back(make_shared<Connection>(storage, it.getConnection()));
     }
 
     return outgoingConnectionsToReturn;
@@ -138,35 +139,21 @@ vector<shared_ptr<Connection>> Node::getOutgoingConnections()
 
 int Node::numberOfOutgoingConnections()
 {
-    vector<shared_ptr<Connection>> connections = getOutgoingConnections();
-    return connections.size();
+    return this->outNeighbours().size();
 }
 
 int Node::numberOfIncomingConnections()
 {
-    vector<shared_ptr<Connection>> connections = getIncomingConnections();
-    return connections.size();
-}
-
-void Node::addIncomingConnection(const weak_ptr<Connection>& connectionToAdd)
-{
-    this->incomingConnections.push_back(connectionToAdd);
-}
-
-void Node::addOutgoingConnection(const weak_ptr<Connection>& connectionToAdd)
-{
-    this->outgoingConnections.push_back(connectionToAdd);
+    return this->inNeighbours().size();
 }
 
 vector<shared_ptr<Node>> Node::getOutgoingNeighbours()
 {
+    shared_ptr<GraphStorage> storage = this->lockStorage();
     vector<shared_ptr<Node>> neighbours;
-
-    for (const auto& conn : this->outgoingConnections)
+    for (auto [vertex, weight] : this->outNeighbours())
     {
-        shared_ptr<Node> endNode = (conn.lock())->getEndNode();
-
-        neighbours.push_back(endNode);
+        neighbours.push_back(storage->getNode(vertex));
     }
 
     return neighbours;
@@ -174,13 +161,12 @@ vector<shared_ptr<Node>> Node::getOutgoingNeighbours()
 
 vector<tuple<shared_ptr<Node>, shared_ptr<Connection>>> Node::getOutgoingNeighboursWithConnection()
 {
+    shared_ptr<GraphStorage> storage = this->lockStorage();
+    NeighbourRange outgoing = this->outNeighbours();
     vector<tuple<shared_ptr<Node>, shared_ptr<Connection>>> neighbours;
-
-    for (const auto& conn : this->outgoingConnections)
+    for (auto it = outgoing.begin(); it != outgoing.end(); ++it)
     {
-        shared_ptr<Node> endNode = (conn.lock())->getEndNode();
-
-        neighbours.emplace_back(endNode, conn.lock());
+        neighbours.emplace_back(storage->getNode((*it).vertex), make_shared<Connection>(storage, it.getConnection()));
     }
 
     return neighbours;
@@ -188,17 +174,15 @@ vector<tuple<shared_ptr<Node>, shared_ptr<Connection>>> Node::getOutgoingNeighbo
 
 vector<shared_ptr<Node>> Node::getIncomingNeighbours()
 {
+    shared_ptr<GraphStorage> storage = this->lockStorage();
     vector<shared_ptr<Node>> neighbours;
-
-    for (const auto& conn : this->incomingConnections)
+    for (auto [vertex, weight] : this->inNeighbours())
     {
-        shared_ptr<Node> startNode = (conn.lock())->getStartNode();
-
-        neighbours.push_back(startNode);
+        neighbours.push_back(storage->getNode(vertex));
     }
 
     return neighbours;
 }
 
-Node::~Node() 
+Node::~Node()
 = default;
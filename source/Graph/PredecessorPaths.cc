@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#include "Graph/PredecessorPaths.h"
+
+using namespace std;
+using namespace GraphModule;
+
+PredecessorPaths::PredecessorPaths(const int* parents, int numberOfVertices, int source)
+{
+    if (source < 0 || source >= numberOfVertices)
+    {
+        throw invalid_argument("Invalid source vertex " + to_string(source));
+    }
+    this->parents = parents;
+    this->numberOfVertices = numberOfVertices;
+    this->source = source;
+}
+
+PredecessorPaths::PredecessorPaths(const vector<int>& parents, int source)
+    : PredecessorPaths(parents.data(), parents.size(), source)
+{
+}
+
+int PredecessorPaths::getSource() const
+{
+    return this->source;
+}
+
+int PredecessorPaths::getNumberOfVertices() const
+{
+    return this->numberOfVertices;
+}
+
+bool PredecessorPaths::hasPath(int target) const
+{
+    return target == this->source || this->parents[target] != -1;
+}
+
+vector<int> PredecessorPaths::path(int target) const
+{
+    vector<int> vertices;
+    this->path(target, vertices);
+    return vertices;
+}
+
+void PredecessorPaths::path(int target, vector<int>& vertices) const
+{
+    vertices.clear();
+    if (!this->hasPath(target))
+    {
+        return;
+    }
+
+    // A path never repeats a vertex, so a longer walk means the predecessors are not a tree.
+    for (int v = target; v != -1; v = this->parents[v])
+    {
+        if (static_cast<int>(vertices.size()) == this->numberOfVertices)
+        {
+            throw runtime_error("The predecessors of vertex " + to_string(target + 1) + " go round a cycle");
+        }
+        vertices.push_back(v);
+    }
+    if (vertices.back() != this->source)
+    {
+        throw runtime_error("The predecessors of vertex " + to_string(target + 1) + " do not lead to the source");
+    }
+    reverse(vertices.begin(), vertices.end());
+}
+
+PredecessorPaths::Iterator PredecessorPaths::begin() const
+{
+    return Iterator(this, 0);
+}
+
+PredecessorPaths::Iterator PredecessorPaths::end() const
+{
+    return Iterator(this, this->numberOfVertices);
+}
+
+PredecessorPaths::Iterator::Iterator(const PredecessorPaths* paths, int target)
+{
+    this->paths = paths;
+    this->route.target = target;
+    this->load();
+}
+
+void PredecessorPaths::Iterator::load()
+{
+    if (this->route.target < this->paths->numberOfVertices)
+    {
+        this->paths->path(this->route.target, this->route.vertices);
+    }
+}
+
+const PredecessorPaths::Route& PredecessorPaths::Iterator::operator*() const
+{
+    return this->route;
+}
+
+const PredecessorPaths::Route* PredecessorPaths::Iterator::operator->() const
+{
+    return &this->route;
+}
+
+PredecessorPaths::Iterator& PredecessorPaths::Iterator::operator++()
+{
+    this->route.target++;
+    this->load();
+    return *this;
+}
+
+bool PredecessorPaths::Iterator::operator==(const Iterator& other) const
+{
+    return this->paths == other.paths && this->route.target == other.route.target;
+}
+
+bool PredecessorPaths::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+PredecessorPaths::~PredecessorPaths()
+= default;
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <utility>
+
+#include "Graph/ShortestPathTrees.h"
+
+using namespace std;
+using namespace GraphModule;
+
+ShortestPathTrees::ShortestPathTrees(vector<int> sources, int numberOfVertices)
+{
+    size_t cells = sources.size() * static_cast<size_t>(numberOfVertices);
+    this->sources = std::move(sources);
+    this->numberOfVertices = numberOfVertices;
+    this->distances = vector<int>(cells);
+    this->parents = vector<int>(cells);
+}
+
+int ShortestPathTrees::getNumberOfTrees() const
+{
+    return this->sources.size();
+}
+
+int ShortestPathTrees::getNumberOfVertices() const
+{
+    return this->numberOfVertices;
+}
+
+int ShortestPathTrees::getSource(int tree) const
+{
+    return this->sources[tree];
+}
+
+int ShortestPathTrees::getDistance(int tree, int vertex) const
+{
+    return this->distances[static_cast<size_t>(tree) * this->numberOfVertices + vertex];
+}
+
+int ShortestPathTrees::getParent(int tree, int vertex) const
+{
+    return this->parents[static_cast<size_t>(tree) * this->numberOfVertices + vertex];
+}
+
+const int* ShortestPathTrees::distanceRow(int tree) const
+{
+    return this->distances.data() + static_cast<size_t>(tree) * this->numberOfVertices;
+}
+
+const int* ShortestPathTrees::parentRow(int tree) const
+{
+    return this->parents.data() + static_cast<size_t>(tree) * this->numberOfVertices;
+}
+
+int* ShortestPathTrees::distanceRow(int tree)
+{
+    return this->distances.data() + static_cast<size_t>(tree) * this->numberOfVertices;
+}
+
+int* ShortestPathTrees::parentRow(int tree)
+{
+    return this->parents.data() + static_cast<size_t>(tree) * this->numberOfVertices;
+}
+
+PredecessorPaths ShortestPathTrees::paths(int tree) const
+{
+    return PredecessorPaths(this->parentRow(tree), this->numberOfVertices, this->sources[tree]);
+}
+
+ShortestPathTrees::~ShortestPathTrees()
+= default;
@@ -0,0 +1,187 @@
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+#include "Graph/StronglyConnectedComponents.h"
+#include "Graph/CSRGraph.h"
+
+using namespace std;
+using namespace GraphModule;
+
+StronglyConnectedComponents::StronglyConnectedComponents(const CSRGraph& snapshot, bool withCondensation)
+{
+    int numberOfVertices = snapshot.getNumberOfVertices();
+    ArrayView<uint32_t> offsets = snapshot.getOffsets();
+    ArrayView<uint32_t> targets = snapshot.getTargets();
+    this->withCondensation = withCondensation;
+
+    // Open vertices hold their index, from 1 up, and closed ones the count c down from V - 1 of their component. The
+    // index is given back as vertices close, so an open index stays below every c and one comparison serves both.
+    vector<int>& rindex = this->components;
+    rindex.assign(numberOfVertices, 0);
+    vector<bool> root(numberOfVertices, false);
+    vector<int> members; // Vertices visited but not yet in a component, the stack of Tarjan's algorithm
+    struct Frame
+    {
+        int vertex;
+        uint32_t arc; // Next arc of the vertex to follow
+    };
+    vector<Frame> frames; // The DFS path, in place of recursion
+    this->componentOffsets = {0};
+    this->componentVertices.reserve(numberOfVertices);
+    if (withCondensation)
+    {
+        this->condensationOffsets = {0};
+        this->lastSource.assign(numberOfVertices, -1);
+    }
+
+    int index = 1;
+    int c = numberOfVertices - 1;
+    for (int start = 0; start < numberOfVertices; start++)
+    {
+        if (rindex[start] != 0)
+        {
+            continue;
+        }
+        rindex[start] = index++;
+        root[start] = true;
+        frames.push_back({start, offsets[start]});
+
+        while (!frames.empty())
+        {
+            int v = frames.back().vertex;
+            if (frames.back().arc < offsets[v + 1])
+            {
+                int w = targets[frames.back().arc++];
+                if (rindex[w] == 0)
+                {
+                    rindex[w] = index++;
+                    root[w] = true;
+                    frames.push_back({w, offsets[w]});
+                }
+                else if (rindex[w] < rindex[v])
+                {
+                    rindex[v] = rindex[w];
+                    root[v] = false;
+                }
+                continue;
+            }
+
+            // Every arc of v is done. A root closes its component with the members above it, others wait for theirs.
+            frames.pop_back();
+            if (root[v])
+            {
+                int first = this->componentVertices.size();
+                index--;
+                while (!members.empty() && rindex[v] <= rindex[members.back()])
+                {
+                    int w = members.back();
+                    members.pop_back();
+                    rindex[w] = c;
+                    index--;
+                    this->componentVertices.push_back(w);
+                }
+                rindex[v] = c;
+                c--;
+                this->componentVertices.push_back(v);
+                this->componentOffsets.push_back(this->componentVertices.size());
+                if (withCondensation)
+                {
+                    this->close(snapshot, first);
+                }
+            }
+            else
+            {
+                members.push_back(v);
+            }
+
+            if (!frames.empty())
+            {
+                int u = frames.back().vertex;
+                if (rindex[v] < rindex[u])
+                {
+                    rindex[u] = rindex[v];
+                    root[u] = false;
+                }
+            }
+        }
+    }
+
+    for (int v = 0; v < numberOfVertices; v++)
+    {
+        this->components[v] = numberOfVertices - 1 - rindex[v];
+    }
+    this->componentSizes = vector<int>(this->componentOffsets.size() - 1);
+    for (size_t component = 0; component + 1 < this->componentOffsets.size(); component++)
+    {
+        this->componentSizes[component] = this->componentOffsets[component + 1] - this->componentOffsets[component];
+    }
+    this->lastSource = vector<int>();
+}
+
+void StronglyConnectedComponents::close(const CSRGraph& snapshot, int first)
+{
+    // Every arc out of a component that just closed leads into itself or into a component closed before it, whose id is
+    // already final in rindex.
+    ArrayView<uint32_t> offsets = snapshot.getOffsets();
+    ArrayView<uint32_t> targets = snapshot.getTargets();
+    int numberOfVertices = snapshot.getNumberOfVertices();
+    int component = this->componentOffsets.size() - 2;
+    for (size_t i = first; i < this->componentVertices.size(); i++)
+    {
+        int u = this->componentVertices[i];
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+        {
+            int target = numberOfVertices - 1 - this->components[targets[arc]];
+            if (target != component && this->lastSource[target] != component)
+            {
+                this->lastSource[target] = component;
+                this->condensationTargets.push_back(target);
+            }
+        }
+    }
+    this->condensationOffsets.push_back(this->condensationTargets.size());
+}
+
+int StronglyConnectedComponents::getNumberOfComponents() const
+{
+    return this->componentSizes.size();
+}
+
+const vector<int>& StronglyConnectedComponents::getComponents() const
+{
+    return this->components;
+}
+
+const vector<int>& StronglyConnectedComponents::getComponentSizes() const
+{
+    return this->componentSizes;
+}
+
+const vector<int>& StronglyConnectedComponents::getComponentOffsets() const
+{
+    return this->componentOffsets;
+}
+
+const vector<int>& StronglyConnectedComponents::getComponentVertices() const
+{
+    return this->componentVertices;
+}
+
+bool StronglyConnectedComponents::hasCondensation() const
+{
+    return this->withCondensation;
+}
+
+const vector<uint32_t>& StronglyConnectedComponents::getCondensationOffsets() const
+{
+    return this->condensationOffsets;
+}
+
+const vector<uint32_t>& StronglyConnectedComponents::getCondensationTargets() const
+{
+    return this->condensationTargets;
+}
+
+StronglyConnectedComponents::~StronglyConnectedComponents()
+= default;
@@ -9,16 +9,150 @@
 #include <tuple>
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <cmath>
 
 #include "Graph/UndirectedGraph.h"
 #include "Graph/Node.h"
 #include "Graph/Connection.h"
-#include "Graph/MinHeap.h"
-#include "Graph/HeapNode.h"
+#include "Graph/IndexedHeap.h"
+#include "Graph/BlockedFloydWarshall.h"
+#include "Graph/RepeatedDijkstra.h"
+#include "Graph/BatchedDijkstra.h"
+#include "Graph/PredecessorPaths.h"
+#include "Graph/BreadthFirstSearch.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/GraphStorage.h"
+#include "Graph/GraphFile.h"
 
 using namespace std;
 using namespace GraphModule;
 
+namespace
+{
+    // The kernel for the element and next-hop types of the matrix.
+    template <typename Distance>
+    void runBlockedFloydWarshall(DistanceMatrix& D)
+    {
+        Distance* distances = D.distances<Distance>();
+        if (D.getNextHopWidth() == sizeof(uint16_t))
+        {
+            BlockedFloydWarshall<Distance>::run(distances, D.nextHops<uint16_t>(), D.getStride());
+        }
+        else if (D.getNextHopWidth() == sizeof(uint32_t))
+        {
+            BlockedFloydWarshall<Distance>::run(distances, D.nextHops<uint32_t>(), D.getStride());
+        }
+        else
+        {
+            BlockedFloydWarshall<Distance>::run(distances, D.getStride());
+        }
+    }
+
+    // The blocked kernel reads a tile already closed over its whole block, so a hop may follow a path through a later
+    // vertex than the textbook order allows. Every hop is still on a shortest path, but where several tie at length 0
+    // the hops toward a vertex can go round in a circle. Targets with such a circle get their hops again from a
+    // breadth-first search from the target over the reversed arcs that lie on shortest paths, which is a tree.
+    void untangleNextHops(DistanceMatrix& D, ArrayView<uint32_t> offsets, ArrayView<uint32_t> targets, ArrayView<float> weights)
+    {
+        int numberOfVertices = D.getNumberOfVertices();
+        auto weightOf = [&D, &weights](uint32_t arc)
+        {
+            return D.getType() == DistanceType::FLOAT32 ? weights[arc] : static_cast<int>(weights[arc]);
+        };
+        // The diagonal holds the shortest loop where there is one, but a path ends at its target with nothing left to go.
+        auto tight = [&D](int u, double weight, int v, int target)
+        {
+            if (!D.isReachable(u, target) || !D.isReachable(v, target))
+            {
+                return false;
+            }
+            double slack = weight + (v == target ? 0 : D.getDistance(v, target)) - D.getDistance(u, target);
+            double tolerance = D.getType() == DistanceType::FLOAT32 ? 1e-5 * max(1.0, abs(D.getDistance(u, target))) : 0;
+            return abs(slack) <= tolerance;
+        };
+
+        vector<uint32_t> reverseOffsets(numberOfVertices + 1, 0);
+        vector<uint32_t> reverseArcs(targets.size());
+        for (uint32_t target : targets)
+        {
+            reverseOffsets[target + 1]++;
+        }
+        for (int v = 0; v < numberOfVertices; v++)
+        {
+            reverseOffsets[v + 1] += reverseOffsets[v];
+        }
+        vector<uint32_t> position(reverseOffsets.begin(), reverseOffsets.end() - 1);
+        for (int u = 0; u < numberOfVertices; u++)
+        {
+            for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+            {
+                reverseArcs[position[targets[arc]]++] = arc;
+            }
+        }
+        vector<int> sources(targets.size());
+        for (int u = 0; u < numberOfVertices; u++)
+        {
+            for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
+            {
+                sources[arc] = u;
+            }
+        }
+
+        vector<int> checked(numberOfVertices, -1); // Target for which the hops from a vertex are known to arrive
+        vector<bool> onWalk(numberOfVertices, false);
+        vector<int> walk;
+        for (int target = 0; target < numberOfVertices; target++)
+        {
+            bool tangled = false;
+            checked[target] = target;
+            for (int start = 0; start < numberOfVertices && !tangled; start++)
+            {
+                walk.clear();
+                int u = start;
+                while (checked[u] != target && D.isReachable(u, target))
+                {
+                    if (onWalk[u] || D.getNextHop(u, target) == DistanceMatrix::NO_HOP)
+                    {
+                        tangled = true;
+                        break;
+                    }
+                    onWalk[u] = true;
+                    walk.push_back(u);
+                    u = D.getNextHop(u, target);
+                }
+                for (int v : walk)
+                {
+                    onWalk[v] = false;
+                    checked[v] = target;
+                }
+            }
+            if (!tangled)
+            {
+                continue;
+            }
+
+            vector<int> queue = {target};
+            vector<bool> reached(numberOfVertices, false);
+            reached[target] = true;
+            for (size_t head = 0; head < queue.size(); head++)
+            {
+                int v = queue[head];
+                for (uint32_t index = reverseOffsets[v]; index < reverseOffsets[v + 1]; index++)
+                {
+                    uint32_t arc = reverseArcs[index];
+                    int u = sources[arc];
+                    if (!reached[u] && tight(u, weightOf(arc), v, target))
+                    {
+                        reached[u] = true;
+                        D.setNextHop(u, target, v);
+                        queue.push_back(u);
+                    }
+                }
+            }
+        }
+    }
+}
 
 UndirectedGraph::UndirectedGraph()
 {
@@ -27,125 +161,156 @@ UndirectedGraph::UndirectedGraph()
 
 int UndirectedGraph::getDegreeOfNode(int nodeKey)
 {
-    shared_ptr<Node> node = this->nodes[nodeKey];
-    vector<shared_ptr<Connection>> connections = node->getConnections();
+    // Every edge stores one connection leaving each endpoint, so the out-degree kept by the storage is the degree.
+    return this->storage->outDegree(nodeKey);
+}
 
-    int degree = connections.size();
+vector<int> UndirectedGraph::degreeSequence()
+{
+    const vector<uint32_t>& degrees = this->storage->getOutDegrees();
 
-    
-    for (const auto& nodeToCheck : this->nodes)
-    {
-        vector<shared_ptr<Connection>> connectionsToCheck = nodeToCheck->getConnections();
+    return vector<int>(degrees.begin(), degrees.end());
+}
 
-        for (const auto& connectionToCheck : connectionsToCheck)
-        {
-            shared_ptr<Node> nodeConnectedTo = connectionToCheck->getEndNode();
+bool UndirectedGraph::isDirected()
+{
+    return false;
+}
 
-            if (nodeConnectedTo->getNumber() == node->getNumber())
-            {
-                degree++;
-            }
+void UndirectedGraph::addEdge(const shared_ptr<Node>& node1, const shared_ptr<Node>& node2, float weight)
+{
+    this->addToBipartition(node1->getNumber(), node2->getNumber());
+
+    // One connection per direction, each threaded into the chain of its start node.
+    this->storage->addConnection(node1->getId(), node2->getId(), weight, true);
+    this->storage->addConnection(node2->getId(), node1->getId(), weight, true);
+
+    this->numberOfEdges++;
+}
+
+void UndirectedGraph::loadConnections(const GraphFile& file)
+{
+    // The rows hold both directions of every edge, the file keeps which way each was written as the sides of the vertices.
+    uint32_t numberOfVertices = file.getNumberOfVertices();
+    const uint8_t* sides = file.getSides();
+    this->inDomain.resize(numberOfVertices + 1, false);
+    this->inContradomain.resize(numberOfVertices + 1, false);
+    for (uint32_t v = 0; v < numberOfVertices; v++)
+    {
+        int number = v + 1;
+        if ((sides[v] & IN_DOMAIN) != 0)
+        {
+            this->inDomain[number] = true;
+            this->domain.push_back(number);
+        }
+        if ((sides[v] & IN_CONTRADOMAIN) != 0)
+        {
+            this->inContradomain[number] = true;
+            this->contradomain.push_back(number);
         }
     }
 
-    return degree;
+    this->numberOfEdges += file.getNumberOfArcs() / 2;
 }
 
-void UndirectedGraph::addEdge(const shared_ptr<Node>& node1, const shared_ptr<Node>& node2, float weight)
+vector<uint8_t> UndirectedGraph::getBipartitionSides()
 {
-    int n1 = node1->getNumber();
-    int n2 = node2->getNumber();
-    
-    // find to check if the value is present in the vector
-    auto findDomain = find(domain.begin(), domain.end(), n1);
-    auto findContraDomain = find(contradomain.begin(), contradomain.end(), n2);
+    // Vertex v is the node numbered v + 1, as in a graph file.
+    vector<uint8_t> sides(this->numberOfVertices, 0);
+    for (int v = 0; v < this->numberOfVertices; v++)
+    {
+        int number = v + 1;
+        if (number < static_cast<int>(this->inDomain.size()) && this->inDomain[number])
+        {
+            sides[v] |= IN_DOMAIN;
+        }
+        if (number < static_cast<int>(this->inContradomain.size()) && this->inContradomain[number])
+        {
+            sides[v] |= IN_CONTRADOMAIN;
+        }
+    }
+    return sides;
+}
 
-    if (findDomain == domain.end()) {
+void UndirectedGraph::addToBipartition(int n1, int n2)
+{
+    if (n1 >= static_cast<int>(inDomain.size()))
+    {
+        inDomain.resize(n1 + 1, false);
+    }
+    if (n2 >= static_cast<int>(inContradomain.size()))
+    {
+        inContradomain.resize(n2 + 1, false);
+    }
+
+    if (!inDomain[n1]) {
+        inDomain[n1] = true;
         domain.push_back(n1);
     }
 
-    if (findContraDomain == contradomain.end()) {
+    if (!inContradomain[n2]) {
+        inContradomain[n2] = true;
         contradomain.push_back(n2);
     }
-
-    weak_ptr<Node> node1WeakPtr(node1);
-    weak_ptr<Node> node2WeakPtr(node2);
-
-    shared_ptr<Connection> connection1SharedPtr = make_shared<Connection>(weight, node1WeakPtr, node2WeakPtr, true);
-    shared_ptr<Connection> connection2SharedPtr = make_shared<Connection>(weight, node2WeakPtr, node1WeakPtr, true);
-    
-    this->edges.push_back(connection1SharedPtr);
-    this->edges.push_back(connection2SharedPtr);
-
-    weak_ptr<Connection> connection1WeakPtr(connection1SharedPtr);
-    node1->addConnection(connection1SharedPtr);
-
-    weak_ptr<Connection> connection2WeakPtr(connection2SharedPtr);
-    node2->addConnection(connection2SharedPtr);
-
-    this->numberOfEdges++;
 }
 
 tuple<vector<int>, vector<int>> UndirectedGraph::BFS(int startNodeIndex)
 {
-    int numberOfVertices = this->numberOfVertices; // Number of vertices in the graph.
-    vector<shared_ptr<Node>> nodes = this->nodes;
-    vector<bool> V; // Vector of visited nodes.
-    vector<int> D; // Vector of distances from the start node.
-    vector<int> A; // Vector of parent nodes.
-    vector<vector<int>> levels; // Vector of vectors to store vertices found at each level
-    for (int i = 0; i <= numberOfVertices; i++)
-    {
-        V.push_back(false); // Initialize with false.
-        D.push_back(1000000); // Initialize with infinity.
-        A.push_back(-1); // Initialize with -1.
-    }
-    V[startNodeIndex] = true; // Mark the start node as visited.
-    D[startNodeIndex] = 0; // Set the distance from the start node to itself to 0.
-    A[startNodeIndex] = -1; // Set the parent of the start node to -1.
+    BreadthFirstSearch search = this->breadthFirstLevels(startNodeIndex);
+    return make_tuple(search.getDistances(), search.getParents());
+}
 
-    queue<int> Q; // Create a queue.
-    Q.push(startNodeIndex); // Push the start node to the queue.
-    levels.push_back(vector<int>({startNodeIndex})); // Add the start node to level 0
-    while (!Q.empty())
+void UndirectedGraph::printBFS(const vector<int>& D)
+{
+    // Vertices are bucketed by level in one pass, in ascending order inside every level.
+    vector<int> levelOffsets(1, 0);
+    for (int distance : D)
     {
-        int u = Q.front(); // Get the first element in the queue.
-        Q.pop(); // Remove the first element in the queue.
-        vector<shared_ptr<Connection>> connections = nodes[u]->getConnections(); // Get the connections of the start node.
-
-        for (const auto& conn : connections)
-        {
-            shared_ptr<Node> vNode = (conn)->getEndNode(); // Get the end node of the connection.
-            int v = vNode->getNumber() - 1; // Get the index of the end node of the connection.
-            if (!V[v])
-            { // If the end node of the connection is not visited.
-                V[v] = true; // Mark the end node as visited.
-                D[v] = D[u] + 1; // Set the distance from the start node to the end node to the distance from the start node to the start node of the connection plus 1.
-                A[v] = u; // Set the parent of the end node to the start node of the connection.
-                Q.push(v); // Push the end node to the queue.
+        if (distance < numberOfVertices)
+        {
+            if (distance + 2 > static_cast<int>(levelOffsets.size()))
+            {
+                levelOffsets.resize(distance + 2, 0);
             }
+            levelOffsets[distance + 1]++;
+        }
+    }
+    for (size_t level = 1; level < levelOffsets.size(); level++)
+    {
+        levelOffsets[level] += levelOffsets[level - 1];
+    }
+    vector<int> levelVertices(levelOffsets.back());
+    vector<int> position(levelOffsets.begin(), levelOffsets.end() - 1);
+    for (int i = 0; i < numberOfVertices; i++)
+    {
+        if (D[i] < numberOfVertices)
+        {
+            levelVertices[position[D[i]]++] = i;
         }
     }
 
-    return make_tuple(D, A);
+    // Print the levels and vertices found in each level, up to the first empty one.
+    for (size_t level = 0; level + 1 < levelOffsets.size() && levelOffsets[level] < levelOffsets[level + 1]; level++)
+    {
+        cout << level << ":";
+        for (int i = levelOffsets[level]; i < levelOffsets[level + 1]; i++)
+        {
+            cout << " " << this->storage->getNode(levelVertices[i])->getNumber();
+        }
+        cout << endl;
+    }
 }
 
-void UndirectedGraph::printBFS(vector<int> D)
+void UndirectedGraph::printBFS(const BreadthFirstSearch& search)
 {
-    // Print the levels and vertices found in each level.
-    for (int level = 0; level <= numberOfVertices; level++) {
-        bool foundVertices = false;
-        for (int i = 0; i < numberOfVertices; i++) {
-            if (D[i] == level) {
-                if (!foundVertices) {
-                    cout << level << ":";
-                    foundVertices = true;
-                }
-                cout << " " << nodes[i]->getNumber();
-            }
-        }
-        if (!foundVertices) {
-            break; // No more vertices to print.
+    const vector<int>& levelOffsets = search.getLevelOffsets();
+    const vector<int>& levelVertices = search.getLevelVertices();
+    for (int level = 0; level < search.getNumberOfLevels(); level++)
+    {
+        cout << level << ":";
+        for (int i = levelOffsets[level]; i < levelOffsets[level + 1]; i++)
+        {
+            cout << " " << this->storage->getNode(levelVertices[i])->getNumber();
         }
         cout << endl;
     }
@@ -155,7 +320,7 @@ vector<int> UndirectedGraph::eulerianCycle(int startNodeIndex)
 {
     int numberOfVertices = this->numberOfVertices; // Number of vertices in the graph.
     vector<vector<int>> C;
-    int numberOfConnectionsBeginNode = this->getDegreeOfNode(startNodeIndex)/2;
+    int numberOfConnectionsBeginNode = this->getDegreeOfNode(startNodeIndex);
     int beginNodeIndex = startNodeIndex;
     if (numberOfConnectionsBeginNode == 0) // If the initial node is not connected we don't have a cycle, it needs to be on the same connected component
     { 
@@ -163,7 +328,7 @@ vector<int> UndirectedGraph::eulerianCycle(int startNodeIndex)
     }
 
     for (int i = 0; i < numberOfVertices; i++){
-        if(this->nodes[i]->getConnections().size()%2 != 0) //If there is a node that has an odd degree we don't have a cycle
+        if(this->getDegreeOfNode(i)%2 != 0) //If there is a node that has an odd degree we don't have a cycle
         {
             return vector<int>({0});
         }
@@ -174,7 +339,7 @@ vector<int> UndirectedGraph::eulerianCycle(int startNodeIndex)
         vector<int> connections;
         for (int j = 0; j < numberOfVertices; j++)
         {
-            tuple<bool, shared_ptr<Connection>> returnedValues = this->nodes[i]->getConnectionWith(this->nodes[j]);
+            tuple<bool, shared_ptr<Connection>> returnedValues = this->storage->getNode(i)->getConnectionWith(this->storage->getNode(j));
             if (get<0>(returnedValues))
             {
                 connections.push_back(false); 
@@ -230,10 +395,8 @@ tuple<bool, vector<int>, vector<vector<int>>> UndirectedGraph::searchEulerianSub
     do
     {
         int u = -1;
-        auto neighbours = this->nodes[v]->getNeighbours();
-        for (const auto& neighbour : neighbours)
+        for (auto [neighbourIndex, weight] : this->storage->getNode(v)->outNeighbours())
         {
-            int neighbourIndex = neighbour->getNumber() - 1;
             if (!adjMatrix[neighbourIndex][v]) { // Selects an edge that C=false
                 u = neighbourIndex;
                 break;
@@ -252,11 +415,8 @@ tuple<bool, vector<int>, vector<vector<int>>> UndirectedGraph::searchEulerianSub
     for(auto i = cycle.begin(); i != cycle.end(); i++) // Checks for subcycles
     {
         int node = *i;
-        auto neighbours = this->nodes[node]->getNeighbours();
-        
-        for (const auto& neighbour : neighbours)
+        for (auto [neighbourIndex, weight] : this->storage->getNode(node)->outNeighbours())
         {
-            int neighbourIndex = neighbour->getNumber() - 1;
             if (!adjMatrix[neighbourIndex][node]) 
             {
                 tuple<bool, vector<int>, vector<vector<int>>> returnedValues = searchEulerianSubcycle(node, adjMatrix);
@@ -295,148 +455,178 @@ void UndirectedGraph::printEulerianCycle(vector<int> cycle)
     cout << endl;
 }
 
-tuple<vector<int>, vector<int>> UndirectedGraph::dijkstra(int startNodeIndex)
+void UndirectedGraph::printDijkstra(int startNodeIndex, const vector<int>& D, const vector<int>& A)
 {
-    int numberOfVertices = this->numberOfVertices; // Number of vertices in the graph.
-    vector<shared_ptr<Node>> nodes = this->nodes; // Vector of nodes in the graph.
-    vector<int> D = vector<int>(numberOfVertices); // Vector of distances from the start node.
-    vector<int> A = vector<int>(numberOfVertices); // Vector of parent nodes.
-    vector<bool> C(numberOfVertices, false); // Vector of visited nodes.
-    int visitedNodes = 0; // Counter for the number of visited nodes.
-
-    for (int i = 0; i < numberOfVertices; i++)
+    // Every path is built in the one buffer of the view, so printing them all is linear in their total length.
+    for (const PredecessorPaths::Route& route : PredecessorPaths(A, startNodeIndex))
     {
-        D[i] = 1000000; // Initialize with infinity.
-        A[i] = -1; // Initialize with -1.
+        cout << route.target + 1 << ": ";
+        for (size_t j = 0; j < route.vertices.size(); j++)
+        {
+            cout << (j == 0 ? "" : ",") << route.vertices[j] + 1;
+        }
+        if (route.vertices.empty())
+        {
+            cout << "; d=inf" << endl; // Not reached from the start
+        }
+        else
+        {
+            cout << "; d=" << D[route.target] << endl;
+        }
     }
+}
 
-    D[startNodeIndex] = 0; // Set the distance from the start node to itself to 0.
-    
-    A[startNodeIndex] = -1; // Set the parent of the start node to -1.
+DistanceMatrix UndirectedGraph::floydWarshall(DistanceType type, bool withNextHops)
+{
+    DistanceMatrix D(this->numberOfVertices, type, withNextHops);
+    this->floydWarshall(D);
+    return D;
+}
 
-    MinHeap minHeap = MinHeap(); // Create a min heap. 
-    for (int i = 0; i < numberOfVertices; i++)
+void UndirectedGraph::floydWarshall(DistanceMatrix& D)
+{
+    if (D.getNumberOfVertices() != this->numberOfVertices)
     {
-        minHeap.insert(this->nodes[i], D[i]);
+        throw invalid_argument("The distance matrix has " + to_string(D.getNumberOfVertices()) + " vertices, the graph " + to_string(this->numberOfVertices));
     }
 
-    while (visitedNodes < numberOfVertices)
+    vector<uint32_t> offsets;
+    vector<uint32_t> targets;
+    vector<float> weights;
+    this->collectArcs(offsets, targets, weights);
+
+    // A loop replaces the 0 of its vertex. Weights are truncated to int unless the matrix holds floats.
+    D.reset();
+    for (int i = 0; i < this->numberOfVertices; i++)
     {
-        shared_ptr<Node> u = minHeap.popMin();
-        C[u->getNumber() - 1] = true;
-        visitedNodes++;
-        vector<shared_ptr<Connection>> uConnections = u->getConnections();
-        for (auto & uConnection : uConnections)
-        {
-            int otherNodeNumber = uConnection->getEndNode()->getNumber();
-            if (!C[otherNodeNumber - 1])
+        for (uint32_t arc = offsets[i]; arc < offsets[i + 1]; arc++)
+        {
+            D.setDistance(i, targets[arc], D.getType() == DistanceType::FLOAT32 ? weights[arc] : static_cast<int>(weights[arc]));
+            if (D.hasNextHops())
             {
-                shared_ptr<Node> v = uConnection->getEndNode();
-                int w = uConnection->getWeight();
-                if (D[v->getNumber() - 1] > D[u->getNumber() - 1] + w) 
-                {
-                    D[v->getNumber() - 1] = D[u->getNumber() - 1] + w;
-                    A[v->getNumber() - 1] = u->getNumber() - 1;
-                    minHeap.updatePriority(v, D[v->getNumber() - 1]);
-                }
+                D.setNextHop(i, targets[arc], targets[arc]);
             }
         }
+    }
 
+    switch (D.getType())
+    {
+        case DistanceType::INT32:
+            runBlockedFloydWarshall<int32_t>(D);
+            break;
+        case DistanceType::FLOAT32:
+            runBlockedFloydWarshall<float>(D);
+            break;
+        case DistanceType::UINT16:
+            runBlockedFloydWarshall<uint16_t>(D);
+            break;
+    }
+    if (D.hasNextHops())
+    {
+        untangleNextHops(D, offsets, targets, weights);
     }
+}
 
-    return make_tuple(D, A);
+DistanceMatrix UndirectedGraph::allPairsShortestPaths(AllPairsEngine engine, DistanceType type, bool withNextHops)
+{
+    DistanceMatrix D(this->numberOfVertices, type, withNextHops);
+    this->allPairsShortestPaths(D, engine);
+    return D;
 }
 
-void UndirectedGraph::printDijkstra(int startNodeIndex, vector<int> D, vector<int> A)
+void UndirectedGraph::allPairsShortestPaths(DistanceMatrix& D, AllPairsEngine engine)
 {
-    for (int i = 0; i < numberOfVertices; i++)
+    if (D.getNumberOfVertices() != this->numberOfVertices)
     {
-        vector<int> path;
-        int currentNodeIndex = i;
-        while (currentNodeIndex != startNodeIndex)
-        {
-            path.insert(path.begin(), currentNodeIndex + 1);
-            currentNodeIndex = A[currentNodeIndex];
-        }
-        path.insert(path.begin(), startNodeIndex + 1);
+        throw invalid_argument("The distance matrix has " + to_string(D.getNumberOfVertices()) + " vertices, the graph " + to_string(this->numberOfVertices));
+    }
 
-        if (i == startNodeIndex)
-        {
-            cout << path.back() << ": ";
-        }
-        else
+    vector<uint32_t> offsets;
+    vector<uint32_t> targets;
+    vector<float> weights;
+    this->collectArcs(offsets, targets, weights);
+    bool automatic = engine == AllPairsEngine::AUTOMATIC;
+    if (automatic)
+    {
+        engine = RepeatedDijkstra::isSparse(this->numberOfVertices, targets.size()) ? AllPairsEngine::REPEATED_DIJKSTRA
+                                                                                     : AllPairsEngine::FLOYD_WARSHALL;
+    }
+    if (engine == AllPairsEngine::REPEATED_DIJKSTRA)
+    {
+        vector<double> distances(weights.size());
+        for (size_t arc = 0; arc < weights.size(); arc++)
         {
-            cout << path.back() << ": " << startNodeIndex + 1 << ",";
+            distances[arc] = D.getType() == DistanceType::FLOAT32 ? weights[arc] : static_cast<int>(weights[arc]);
+            if (D.getType() == DistanceType::UINT16 && distances[arc] < 0)
+            {
+                throw invalid_argument("A uint16 distance matrix needs non-negative weights");
+            }
         }
 
-        for (long unsigned int j = 1; j < path.size() - 1; j++)
+        // Asked for explicitly, a negative cycle is an error. Chosen automatically, Floyd-Warshall runs instead.
+        RepeatedDijkstra sweep(std::move(offsets), std::move(targets), std::move(distances));
+        if (!automatic || !sweep.hasNegativeCycle())
         {
-            cout << path[j] << ",";
+            sweep.run(D);
+            return;
         }
-        cout << path[path.size() - 1] << "; d=" << D[i] << endl;
     }
+    this->floydWarshall(D);
 }
 
-vector<vector<int>> UndirectedGraph::floydWarshall()
+void UndirectedGraph::collectArcs(vector<uint32_t>& offsets, vector<uint32_t>& targets, vector<float>& weights)
 {
-	vector<vector<int>> D;
+    // One arc per ordered pair of vertices. Between parallel edges the one added first counts, as getConnectionWith finds it.
     int numberOfVertices = this->numberOfVertices;
-	for (int i = 0; i < numberOfVertices; i++) //Populating the Matrix D
+    vector<uint32_t> chosen(numberOfVertices, GraphStorage::NONE);
+    vector<uint32_t> position(numberOfVertices);
+    offsets.assign(1, 0);
+    targets.clear();
+    weights.clear();
+    for (int i = 0; i < numberOfVertices; i++)
     {
-        vector<int> connections;
-		for (int j = 0; j < numberOfVertices; j++) //verify if it is not actually just <= for all the other cases
+        for (uint32_t conn = this->storage->firstOutgoing(i); conn != GraphStorage::NONE; conn = this->storage->nextOutgoing(conn))
         {
-            tuple<bool,shared_ptr<Connection>> returnedValues = this->nodes[i]->getConnectionWith(this->nodes[j]);
-            if (get<0>(returnedValues))
+            uint32_t j = this->storage->getEndNode(conn);
+            if (chosen[j] == GraphStorage::NONE)
             {
-                int weight = get<1>(returnedValues)->getWeight();
-                connections.push_back(weight); 
+                chosen[j] = conn;
+                position[j] = targets.size();
+                targets.push_back(j);
+                weights.push_back(this->storage->getWeight(conn));
             }
-            else 
+            else if (conn < chosen[j])
             {
-                if (i==j)
-                {
-                    connections.push_back(0);
-                }
-                else
-                {
-                    connections.push_back(1000000);
-                }
+                chosen[j] = conn;
+                weights[position[j]] = this->storage->getWeight(conn);
             }
-		}
-        D.push_back(connections); // should print this to verify correctness
-	}
-
-    for (int k = 0; k < numberOfVertices; k++) 
-    {
-        for (int i = 0; i < numberOfVertices; i++) 
+        }
+        for (uint32_t conn = this->storage->firstOutgoing(i); conn != GraphStorage::NONE; conn = this->storage->nextOutgoing(conn))
         {
-            for (int j = 0; j < numberOfVertices; j++) 
-            {
-                if (D[i][k] + D[k][j] < D[i][j]) {
-                    D[i][j] = D[i][k] + D[k][j];
-                }
-            }
+            chosen[this->storage->getEndNode(conn)] = GraphStorage::NONE;
         }
+        offsets.push_back(targets.size());
     }
-
-    return D;
 }
 
-void UndirectedGraph::printFloydWarshall(vector<vector<int>> D)
+void UndirectedGraph::printFloydWarshall(const DistanceMatrix& D)
 {
     for (int i = 0; i < numberOfVertices; i++)
     {
         cout << i + 1 << ": ";
         for (int j = 0; j < numberOfVertices; j++)
         {
-            if (D[i][j] == 1000000)
+            if (!D.isReachable(i, j))
             {
                 cout << "inf" << " ";
             }
+            else if (D.getType() == DistanceType::FLOAT32)
+            {
+                cout << static_cast<float>(D.getDistance(i, j)) << " ";
+            }
             else
             {
-                cout << D[i][j] << " ";
+                cout << static_cast<long long>(D.getDistance(i, j)) << " ";
             }
         }
         cout << endl;
@@ -445,19 +635,13 @@ void UndirectedGraph::printFloydWarshall(vector<vector<int>> D)
 
 vector<int> UndirectedGraph::prim()
 {
-    int V = this->numberOfVertices;
-    adj = new list<node_weight_pair>[V];
-
-    for(auto conn:this->edges)
-    { // Builds the adjacency matrix
-        int i = conn->getStartNode()->getNumber() - 1;
-        int j = conn->getEndNode()->getNumber() - 1;
-        float w = conn->getWeight();
-        adj[i].push_back(make_pair(j, w));
-        adj[j].push_back(make_pair(i, w));
-    }
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets();
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+    ArrayView<float> weights = snapshot->getWeights();
+    int V = snapshot->getNumberOfVertices();
     
-    priority_queue< node_weight_pair, vector <node_weight_pair> , greater<node_weight_pair> > heap; // Heap as a priory queue
+    IndexedHeap<float> heap(V); // Every vertex once, keyed by the lightest edge that reaches the tree
  
     int start_node = 0; // Vertex 0 as the arbitrary start node 
  
@@ -467,31 +651,24 @@ vector<int> UndirectedGraph::prim()
  
     vector<bool> visited(V, false);
  
-    heap.push(make_pair(0, start_node)); // Initialization
+    heap.push(start_node, 0); // Initialization
     K[start_node] = 0;
  
     while (!heap.empty())
     {
-        int u = heap.top().second; // Extract the minimum
-        heap.pop();
-        
-        if(visited[u] == true)
-        {
-            continue;
-        }
+        int u = heap.pop(); // Extract the minimum
 
         visited[u] = true;  // Visited
  
-        list< pair<int, float> >::iterator i;
-        for (i = adj[u].begin(); i != adj[u].end(); ++i)
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
         {
-            int v = (*i).first;
-            float weight = (*i).second;
+            int v = targets[arc];
+            float weight = weights[arc];
 
             if (visited[v] == false && K[v] > weight)
             {
                 K[v] = weight;
-                heap.push(make_pair(K[v], v));
+                heap.pushOrDecrease(v, K[v]);
                 A[v] = u;
             }
         }
@@ -510,7 +687,7 @@ void UndirectedGraph::printPrim(vector<int> A)
             }
         message += to_string(A[i]+1) + "-" + to_string(i+1);
 
-        auto nodeOnTheOtherEnd = get<1>(this->nodes[i]->getConnectionWith(this->nodes[A[i]]));
+        auto nodeOnTheOtherEnd = get<1>(this->storage->getNode(i)->getConnectionWith(this->storage->getNode(A[i])));
         weightSum += nodeOnTheOtherEnd->getWeight();
     }
     cout << weightSum << endl;
@@ -523,17 +700,11 @@ vector<int>  UndirectedGraph::coloring()
     /  - [X] a coloração mínima e 
     /  - [X] qual número cromático foi utilizado em cada vertice */
 
-    int V = this->numberOfVertices;
-    color_adj = new list<int>[V]; // Adjacency list for coloring algorithm
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets(); // Adjacency rows for coloring algorithm
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+    int V = snapshot->getNumberOfVertices();
     vector<int> colors; // Array to save the final results of the coloring
-
-    for(auto conn:this->edges)
-    { // Builds the adjacency matrix
-        int i = conn->getStartNode()->getNumber() - 1;
-        int j = conn->getEndNode()->getNumber() - 1;
-        color_adj[i].push_back(j);
-        color_adj[j].push_back(i);
-    }
  
     for (int u = 0; u < V; u++)
     {  // Initialize values, only the first is 0 for now
@@ -547,20 +718,15 @@ vector<int>  UndirectedGraph::coloring()
         }
     }
 
-    bool used_color[V]; // Array to indicate if color is already being used (True) by adjacent vertices
-    for (int i = 0; i < V; i++)
-    {
-        used_color[i] = false;
-    }
+    vector<bool> used_color(V, false); // Array to indicate if color is already being used (True) by adjacent vertices
 
     for (int u = 1; u < V; u++)
     {  // Coloring process
         
-        list<int>::iterator i;
-        for (i = color_adj[u].begin(); i != color_adj[u].end(); ++i)
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
         { // Setting adjancent vertices colors as used
-            if (colors[*i] != -1)
-                used_color[colors[*i]] = true;
+            if (colors[targets[arc]] != -1)
+                used_color[colors[targets[arc]]] = true;
         }
 
         int color;
@@ -573,11 +739,11 @@ vector<int>  UndirectedGraph::coloring()
         }
         colors[u] = color;
 
-        for (i = color_adj[u].begin(); i != color_adj[u].end(); ++i)
+        for (uint32_t arc = offsets[u]; arc < offsets[u + 1]; arc++)
         { // Resetting for next iteration
-            if (colors[*i] != -1)
+            if (colors[targets[arc]] != -1)
             {
-                used_color[colors[*i]] = false;
+                used_color[colors[targets[arc]]] = false;
             }
         }
     }
@@ -600,23 +766,34 @@ void UndirectedGraph::printColoring(vector<int> colors){
 
 void UndirectedGraph::configureBipartiteGraph()
 {   
+    shared_ptr<const CSRGraph> snapshot = this->getSnapshot();
+    ArrayView<uint32_t> offsets = snapshot->getOffsets();
+    ArrayView<uint32_t> targets = snapshot->getTargets();
+
     m = domain.size();
     n = contradomain.size(); 
-    adjacency = new list<int>[m+1];
-    for(long unsigned int idx = 0; idx < this->edges.size(); idx++)
-    { // Builds adjacency matrix
-        if (idx%2==0){
-            int i = this->edges[idx]->getStartNode()->getNumber();
-            int j = this->edges[idx]->getEndNode()->getNumber();
+
+    bipartiteOffsets = vector<uint32_t>(m + 2, 0);
+    bipartiteTargets.clear();
+    for (int i = 1; i <= m; i++)
+    { // Builds adjacency rows of the domain, keeping only the edges that reach the contra domain
+        for (uint32_t arc = offsets[i - 1]; arc < offsets[i]; arc++)
+        {
+            int j = targets[arc] + 1;
+            if (j >= static_cast<int>(inContradomain.size()) || !inContradomain[j])
+            {
+                continue;
+            }
             if (j%m == 0)
             {
-                adjacency[i].push_back(m);
+                bipartiteTargets.push_back(m);
             }
             else 
             {
-                adjacency[i].push_back(j%m);
+                bipartiteTargets.push_back(j%m);
             }
-        } 
+        }
+        bipartiteOffsets[i + 1] = bipartiteTargets.size();
     }
 }
 
@@ -629,24 +806,14 @@ tuple<int, int*> UndirectedGraph::hopcroftKarp()
 
     configureBipartiteGraph();
 
-    // matching of the domain
-    pairU = new int[m+1];
+    // matching of the domain, initialized as 0
+    pairU = vector<int>(m+1, 0);
  
-    // matching of the counterdomain
-    pairV = new int[n+1];
+    // matching of the counterdomain, initialized as 0
+    pairV = vector<int>(n+1, 0);
  
     // distance of domain
-    dist = new int[m+1];
- 
-    // Initializing as 0 all vertices
-    for (int u=0; u<=m; u++)
-    {
-        pairU[u] = 0; 
-    }
-    for (int v=0; v<=n; v++)
-    {
-        pairV[v] = 0;
-    }
+    dist = vector<int>(m+1);
  
     int result = 0;
  
@@ -661,17 +828,16 @@ tuple<int, int*> UndirectedGraph::hopcroftKarp()
             }
         }
     }
-    return make_tuple(result, pairU);
+    return make_tuple(result, pairU.data());
 }
 
 bool UndirectedGraph::bipartiteGraphDFS(int u)
 {
     if (u != 0)
     {
-        list<int>::iterator i;
-        for (i=adjacency[u].begin(); i!=adjacency[u].end(); ++i)
+        for (uint32_t arc = bipartiteOffsets[u]; arc < bipartiteOffsets[u+1]; arc++)
         {
-            int v = *i; // Adjacent to u
+            int v = bipartiteTargets[arc]; // Adjacent to u
             if (dist[pairV[v]] == dist[u]+1)
             { // Distances results from BFS
                 if (bipartiteGraphDFS(pairV[v]))
@@ -711,10 +877,9 @@ bool UndirectedGraph::bipartiteGraphBFS()
         Q.pop();
         if (dist[u] < dist[0])
         { // If this node is not the void index and can provide a shorter path
-            list<int>::iterator i;
-            for (i=adjacency[u].begin(); i!=adjacency[u].end(); ++i)
+            for (uint32_t arc = bipartiteOffsets[u]; arc < bipartiteOffsets[u+1]; arc++)
             { // Gets all adjacents of u
-                int v = *i;
+                int v = bipartiteTargets[arc];
                 if (dist[pairV[v]] == 1000000)
                 { // If match of v is not explored so far
                     dist[pairV[v]] = dist[u] + 1; 